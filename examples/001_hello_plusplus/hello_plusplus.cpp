@@ -43,9 +43,6 @@ void printstr(const char* str, int x, int y, int tall);
 
 int main(int argc, char *argv[])
 {
-	int i;
-	u16 microprog[16];
-
 	king_init();
 	tetsu_init();
 	
@@ -57,14 +54,7 @@ int main(int argc, char *argv[])
 	king_set_bg_mode(KING_BGMODE_4_PAL, KING_BGMODE_NONE, KING_BGMODE_NONE, KING_BGMODE_NONE);
 	king_set_kram_pages(0, 0, 0, 0);
 
-	for(i = 0; i < 16; i++) {
-		microprog[i] = KING_CODE_NOP;
-	}
-
-	microprog[0] = KING_CODE_BG0_CG_0;
-	king_disable_microprogram();
-	king_write_microprogram(microprog, 0, 16);
-	king_enable_microprogram();
+	king_setup_microprogram(0, 0);  // BG0 only: one 4-color CG read
 
 	tetsu_set_palette(0, 0x0088);
 	tetsu_set_palette(1, 0xE088);
@@ -80,9 +70,7 @@ int main(int argc, char *argv[])
 	king_set_kram_read(0, 1);
 	king_set_kram_write(0, 1);
 	// Clear BG0's RAM
-	for(i = 0x0; i < 0x1E00; i++) {
-		king_kram_write(0);
-	}
+	king_kram_fill(0, 0x1E00);
 	king_set_kram_write(0, 1);
 	printstr("Hello World!", 10, 0x20, 1);
 	printstr("Love, NEC", 11, 0x38, 0);
@@ -113,19 +101,19 @@ void printstr(const char* str, int x, int y, int tall)
 
 void printch(u32 sjis, u32 kram, int tall)
 {
-	u16 px;
+	u16 px[16];
 	int x, y;
 	u8* glyph = romfont_get(sjis, tall ? ROMFONT_ANK_8x16 : ROMFONT_ANK_8x8);
 	for(y = 0; y < (tall ? 16 : 8); y++) {
-		king_set_kram_write(kram + (y << 5), 1);
-		px = 0;
+		px[y] = 0;
 		for(x = 0; x < 8; x++) {
 			if((glyph[y] >> x) & 1) {
-				px |= 1 << (x << 1);
+				px[y] |= 1 << (x << 1);
 			}
 		}
-		king_kram_write(px);
 	}
+	king_set_kram_write(kram, 32);  // one glyph row per BG0 line
+	king_kram_write_block(px, tall ? 16 : 8);
 }
 
 test::test ()
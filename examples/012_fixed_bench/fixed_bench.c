@@ -0,0 +1,177 @@
+/*
+	libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026		libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+//-------------------------------------------------------------------------
+// This example times the 16.16 fixed-point routines in fixed.h against
+// equivalent sequences using the V810's FPU instructions (see fpu.S).
+//
+// Each operation is called BENCH_COUNT times through a function pointer,
+// so call overhead is the same on both sides.  Times are shown in timer
+// ticks (CPU clock / 15) for the whole batch; lower is better.
+//-------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+
+#include <pcfx/types.h>
+#include <pcfx/v810.h>
+#include <pcfx/romfont.h>
+#include <pcfx/king.h>
+#include <pcfx/tetsu.h>
+#include <pcfx/timer.h>
+#include <pcfx/fixed.h>
+
+#define BENCH_COUNT	256
+#define TIMER_PERIOD	0xFFFF
+
+void printch(u32 sjis, u32 kram, int tall);
+void printstr(const char* str, int x, int y, int tall);
+
+fix16 fpu_mul(fix16 a, fix16 b);
+fix16 fpu_div(fix16 a, fix16 b);
+fix16 fpu_recip(fix16 a);
+u32 fpu_mulf_raw(u32 a, u32 b);
+
+typedef fix16 (*binop)(fix16 a, fix16 b);
+typedef fix16 (*unop)(fix16 a);
+
+volatile fix16 sink;
+
+static int elapsed(int start, int end)
+{
+	int diff = start - end;		// timer counts down
+
+	if (diff < 0)
+		diff += TIMER_PERIOD;
+	return diff;
+}
+
+static int time_binop(binop fn, fix16 a, fix16 b)
+{
+	int i, start;
+
+	start = timer_read_counter();
+	for (i = 0; i < BENCH_COUNT; i++)
+		sink = fn(a, b);
+	return elapsed(start, timer_read_counter());
+}
+
+static int time_unop(unop fn, fix16 a)
+{
+	int i, start;
+
+	start = timer_read_counter();
+	for (i = 0; i < BENCH_COUNT; i++)
+		sink = fn(a);
+	return elapsed(start, timer_read_counter());
+}
+
+static fix16 sin_wrap(fix16 a)
+{
+	return fix16_sin(a);
+}
+
+static void show(const char *name, int fixed_ticks, int fpu_ticks, int y)
+{
+	char str[40];
+
+	if (fpu_ticks < 0)
+		sprintf(str, "%-8s %6d      -", name, fixed_ticks);
+	else
+		sprintf(str, "%-8s %6d %6d", name, fixed_ticks, fpu_ticks);
+	printstr(str, 2, y, 0);
+}
+
+int main(int argc, char *argv[])
+{
+
+	king_init();
+	tetsu_init();
+	
+	tetsu_set_priorities(0, 0, 1, 0, 0, 0, 0);
+	tetsu_set_king_palette(0, 0, 0, 0);
+	tetsu_set_rainbow_palette(0);
+
+	king_set_bg_prio(KING_BGPRIO_3, KING_BGPRIO_HIDE, KING_BGPRIO_HIDE, KING_BGPRIO_HIDE, 0);
+	king_set_bg_mode(KING_BGMODE_4_PAL, 0, 0, 0);
+	king_set_kram_pages(0, 0, 0, 0);
+
+	king_setup_microprogram(0, 0);  // BG0 only: one 4-color CG read
+
+	tetsu_set_palette(0, 0x0088);
+	tetsu_set_palette(1, 0xE088);
+	tetsu_set_palette(2, 0xE0F0);
+	tetsu_set_palette(3, 0x602C);
+	tetsu_set_video_mode(TETSU_LINES_262, 0, TETSU_DOTCLOCK_5MHz, TETSU_COLORS_16,
+				TETSU_COLORS_16, 0, 0, 1, 0, 0, 0, 0);
+	king_set_bat_cg_addr(KING_BG0, 0, 0);
+	king_set_bat_cg_addr(KING_BG0SUB, 0, 0);
+	king_set_scroll(KING_BG0, 0, 0);
+	king_set_bg_size(KING_BG0, KING_BGSIZE_256, KING_BGSIZE_256, KING_BGSIZE_256, KING_BGSIZE_256);
+
+	king_set_kram_read(0, 1);
+	king_set_kram_write(0, 1);
+	// Clear BG0's RAM
+	king_kram_fill(0, 0x1E00);
+	king_set_kram_write(0, 1);
+
+	printstr("Fixed-point vs. FPU", 6, 0x08, 1);
+	printstr("op        fix16    fpu", 2, 0x28, 0);
+
+	// Free-running timer: maximum period, no IRQ
+	timer_init();
+	timer_set_period(TIMER_PERIOD);
+	timer_start(0);
+
+	show("mul",   time_binop(fix16_mul, FIX16(3.25), FIX16(-1.5)),
+	              time_binop(fpu_mul,   FIX16(3.25), FIX16(-1.5)), 0x38);
+	show("div<1", time_binop(fix16_div, FIX16(3.25), FIX16(0.75)),
+	              time_binop(fpu_div,   FIX16(3.25), FIX16(0.75)), 0x40);
+	show("div>1", time_binop(fix16_div, FIX16(300.25), FIX16(7.5)),
+	              time_binop(fpu_div,   FIX16(300.25), FIX16(7.5)), 0x48);
+	show("recip", time_unop(fix16_recip, FIX16(7.5)),
+	              time_unop(fpu_recip,   FIX16(7.5)), 0x50);
+	show("sqrt",  time_unop(fix16_sqrt, FIX16(300.25)), -1, 0x58);
+	show("sin",   time_unop(sin_wrap, 100), -1, 0x60);
+	show("mulf",  -1, time_binop((binop)fpu_mulf_raw, 0x40500000, 0xBFC00000), 0x68);
+
+	timer_stop();
+
+	printstr("ticks per 256 calls", 2, 0x80, 0);
+	printstr("(1 tick = 15 cpu cycles)", 2, 0x88, 0);
+
+	return 0;
+}
+
+void printstr(const char* str, int x, int y, int tall)
+{
+	int i;
+	u32 kram = x + (y << 5);
+	int len = strlen(str);
+	for(i = 0; i < len; i++) {
+		printch(str[i], kram + i, tall);
+	}
+}
+
+void printch(u32 sjis, u32 kram, int tall)
+{
+	u16 px[16];
+	int x, y;
+	u8* glyph = romfont_get(sjis, tall ? ROMFONT_ANK_8x16 : ROMFONT_ANK_8x8);
+	for(y = 0; y < (tall ? 16 : 8); y++) {
+		px[y] = 0;
+		for(x = 0; x < 8; x++) {
+			if((glyph[y] >> x) & 1) {
+				px[y] |= 1 << (x << 1);
+			}
+		}
+	}
+	king_set_kram_write(kram, 32);  // one glyph row per BG0 line
+	king_kram_write_block(px, tall ? 16 : 8);
+}
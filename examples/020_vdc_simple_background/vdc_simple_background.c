@@ -30,11 +30,8 @@ const uint16_t char_gfx[] = {
 
 int main(int argc, char *argv[])
 {
-	int i;
-	u16 microprog[16];
 
-	vdc_init_5MHz(VDC0);
-	vdc_init_5MHz(VDC1);
+	vdcm_init_5MHz(VDC_MASK_BOTH);
 
 	king_init();
 	tetsu_init();
@@ -48,14 +45,7 @@ int main(int argc, char *argv[])
 	king_set_bg_mode(KING_BGMODE_4_PAL, 0, 0, 0);
 	king_set_kram_pages(0, 0, 0, 0);
 
-	for(i = 0; i < 16; i++) {
-		microprog[i] = KING_CODE_NOP;
-	}
-
-	microprog[0] = KING_CODE_BG0_CG_0;
-	king_disable_microprogram();
-	king_write_microprogram(microprog, 0, 16);
-	king_enable_microprogram();
+	king_setup_microprogram(0, 0);  // BG0 only: one 4-color CG read
 
 	tetsu_set_palette(0, 0x0088);
 	tetsu_set_palette(1, 0xE088);
@@ -80,29 +70,18 @@ int main(int argc, char *argv[])
 	king_set_kram_write(0, 1);
 
 	// Clear BG0's RAM
-	for(i = 0; i < 0x1E00; i++) {
-		king_kram_write(0);
-	}
+	king_kram_fill(0, 0x1E00);
 
 	// set up the BAT (background attribute table
 	//
-	vdc_set_vram_write(VDC0, 0);
-	for(i = 0; i < (32 * 5); i++) {           /* First 5 lines need to be blank, to avoid covering the title */
-		vdc_vram_write(VDC0, 0x80); /* All tiles are at tile 0x80 (blank) */
-	}
-	for(i = (32 * 5); i < 0x800; i++) {       /* Everything after first 5 lines */
-		vdc_vram_write(VDC0, 0x81); /* All tiles are at tile 0x81 */
-	}
+	vdc_vram_fill(VDC0, 0, 0x80, (32 * 5));                  /* First 5 lines need to be blank, to avoid covering the title */
+	vdc_vram_fill(VDC0, (32 * 5), 0x81, 0x800 - (32 * 5));   /* Everything after first 5 lines: all tiles are at tile 0x81 */
 
 	// set up the character tile definitiions for the two tiles
 	// referenced by the BAT above (one blank, one with a pattern)
 	//
-	for(i = 0; i < 16; i++) {
-		vdc_vram_write(VDC0, 0x00); /* Blank tile */
-	}
-	for(i = 0; i < 16; i++) {
-		vdc_vram_write(VDC0, char_gfx[i]); /* happyface type logo defined above */
-	}
+	vdc_vram_fill(VDC0, 0x800, 0x00, 16);                     /* Blank tile */
+	vdc_vram_write_block(VDC0, 0x810, char_gfx, 16);          /* happyface type logo defined above */
 
 	king_set_kram_write(0, 1);
 	printstr("VDC BG example", 9, 0x10, 1);
@@ -125,18 +104,18 @@ void printstr(const char* str, int x, int y, int tall)
 
 void printch(u32 sjis, u32 kram, int tall)
 {
-	u16 px;
+	u16 px[16];
 	int x, y;
 	u8* glyph = romfont_get(sjis, tall ? ROMFONT_ANK_8x16 : ROMFONT_ANK_8x8);
 	for(y = 0; y < (tall ? 16 : 8); y++) {
-		king_set_kram_write(kram + (y << 5), 1);
-		px = 0;
+		px[y] = 0;
 		for(x = 0; x < 8; x++) {
 			if((glyph[y] >> x) & 1) {
-				px |= 1 << (x << 1);
+				px[y] |= 1 << (x << 1);
 			}
 		}
-		king_kram_write(px);
 	}
+	king_set_kram_write(kram, 32);  // one glyph row per BG0 line
+	king_kram_write_block(px, tall ? 16 : 8);
 }
 
@@ -41,11 +41,9 @@ const uint16_t sprite_image_load_addr = 0x4000;
 int main(int argc, char *argv[])
 {
 	int i, x, y, xl, yl;
-	u16 microprog[16];
 	u32 pad;
 
-	vdc_init_5MHz(VDC0);
-	vdc_init_5MHz(VDC1);
+	vdcm_init_5MHz(VDC_MASK_BOTH);
 	vdc_set_satb_address(VDC0, 0x7000);  // just to show that it doesn't have to be 0xff00
 
 	king_init();
@@ -61,14 +59,7 @@ int main(int argc, char *argv[])
 	king_set_bg_mode(KING_BGMODE_4_PAL, 0, 0, 0);
 	king_set_kram_pages(0, 0, 0, 0);
 
-	for(i = 0; i < 16; i++) {
-		microprog[i] = KING_CODE_NOP;
-	}
-
-	microprog[0] = KING_CODE_BG0_CG_0;
-	king_disable_microprogram();
-	king_write_microprogram(microprog, 0, 16);
-	king_enable_microprogram();
+	king_setup_microprogram(0, 0);  // BG0 only: one 4-color CG read
 
 	tetsu_set_palette(0, 0x0088);
 	tetsu_set_palette(1, 0xE088);
@@ -93,17 +84,12 @@ int main(int argc, char *argv[])
 	king_set_kram_write(0, 1);
 
 	// Clear BG0's RAM
-	for(i = 0; i < 0x1E00; i++) {
-		king_kram_write(0);
-	}
+	king_kram_fill(0, 0x1E00);
 
 	// load sprite data
 	// -> Place at VRAM address set by sprite_image_load_addr
 	//
-	vdc_set_vram_write(VDC0, sprite_image_load_addr);
-	for(i = 0; i < 8*4; i++) {
-		vdc_vram_write(VDC0, spr_data[i]); /* sprite is plus sign */
-	}
+	vdc_vram_write_block(VDC0, sprite_image_load_addr, spr_data, 8*4); /* sprite is plus sign */
 
 	vdc_set(VDC0);
 	vdc_spr_set(0);  // Use sprite #0, but could be any (0 - 63)
@@ -161,18 +147,18 @@ void printstr(const char* str, int x, int y, int tall)
 
 void printch(u32 sjis, u32 kram, int tall)
 {
-	u16 px;
+	u16 px[16];
 	int x, y;
 	u8* glyph = romfont_get(sjis, tall ? ROMFONT_ANK_8x16 : ROMFONT_ANK_8x8);
 	for(y = 0; y < (tall ? 16 : 8); y++) {
-		king_set_kram_write(kram + (y << 5), 1);
-		px = 0;
+		px[y] = 0;
 		for(x = 0; x < 8; x++) {
 			if((glyph[y] >> x) & 1) {
-				px |= 1 << (x << 1);
+				px[y] |= 1 << (x << 1);
 			}
 		}
-		king_kram_write(px);
 	}
+	king_set_kram_write(kram, 32);  // one glyph row per BG0 line
+	king_kram_write_block(px, tall ? 16 : 8);
 }
 
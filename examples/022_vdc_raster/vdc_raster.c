@@ -27,41 +27,45 @@ extern u8 font[];
 
 volatile int sda_frame_count = 0;
 volatile int scroll_x = 0;
-volatile int scroll_y = 0;
 
-volatile int scroll_band = 0;
 const int scroll_1_line = 104;
 const int scroll_2_line = 144;
 
+// The screen is split in 3 bands: the top one stays still, the middle one
+// scrolls at half speed and the bottom one at full speed.
+//
+// The raster table lists the scroll values to set at each split; a new table
+// is built whenever scroll_x changes, and takes over at the next VBlank.
+// Note that BYR is set to (line - 1), so that each band continues where the
+// previous one left off.
+//
+void build_raster_table(void)
+{
+	vdc_raster_begin(VDC0);
+	vdc_raster_add(VDC0, 0, VDC_REG_BXR, 0);                      // At top of frame, "lock it in" to origin
+	vdc_raster_add(VDC0, 0, VDC_REG_BYR, 0);
+	vdc_raster_add(VDC0, scroll_1_line, VDC_REG_BXR, (scroll_x >> 1));
+	vdc_raster_add(VDC0, scroll_1_line, VDC_REG_BYR, scroll_1_line - 1);
+	vdc_raster_add(VDC0, scroll_2_line, VDC_REG_BXR, scroll_x);
+	vdc_raster_add(VDC0, scroll_2_line, VDC_REG_BYR, scroll_2_line - 1);
+	vdc_raster_end(VDC0);
+}
+
 // Note:
-// If the raster interrupt could happen during other VRAM updates, you should use
-// vdc_get_last_regnum() to fetch the VDC register last used, and set it again at
-// the end of the interrupt (see "FXBOAD" documentation from GMaker development kit)
+// vdc_raster_irq() puts back the VDC register that was selected when the
+// interrupt came in, so the main program can keep updating VRAM meanwhile
+// (see "FXBOAD" documentation from GMaker development kit)
 //
 __attribute__ ((interrupt_handler)) void my_video_irq (void)
 {
    int16_t vdc_stat = vdc_status(0);
 
-   if (vdc_stat & VDC_STAT_RR )
-   {
-      if (scroll_band == 0) {
-         vdc_set_scroll(VDC0, (scroll_x>>1), scroll_1_line - 1);
-	 vdc_set_raster(VDC0, scroll_2_line + 64);  // Need to set raster at line <n> + 64
-      }
-      else
-         vdc_set_scroll(VDC0, scroll_x, scroll_2_line - 1);
-
-      scroll_band++;
-   }
+   vdc_raster_irq(VDC0, vdc_stat);     // does the splits, and the table swap at VBlank
 
    if (vdc_stat & VDC_STAT_VD )
    {
       sda_frame_count++;
 
-      scroll_band = 0;
-
-      vdc_set_scroll(VDC0, scroll_x, scroll_y);
-
       if ((sda_frame_count & 1) == 0)
       {
          scroll_x++;
@@ -69,9 +73,8 @@ __attribute__ ((interrupt_handler)) void my_video_irq (void)
 	 if (scroll_x == 128)
             scroll_x = 0;
 
+         build_raster_table();
       }
-      vdc_set_scroll(VDC0, 0, 0);                // At top of frame, "lock it in" to origin
-      vdc_set_raster(VDC0, scroll_1_line + 64);  // Setup next raster interrupt
    }
 }
 
@@ -80,10 +83,8 @@ int main(int argc, char *argv[])
 {
 	int i,j;
 	u16 a, img;
-	u16 microprog[16];
 
-	vdc_init_5MHz(VDC0);
-	vdc_init_5MHz(VDC1);
+	vdcm_init_5MHz(VDC_MASK_BOTH);
 
 	vdc_setreg(VDC0, VDC_REG_MWR, VDC_MWR_SCREEN_32x32);
 	vdc_set_scroll(VDC0, 0, 0);
@@ -100,14 +101,7 @@ int main(int argc, char *argv[])
 	king_set_bg_mode(KING_BGMODE_4_PAL, 0, 0, 0);
 	king_set_kram_pages(0, 0, 0, 0);
 
-	for(i = 0; i < 16; i++) {
-		microprog[i] = KING_CODE_NOP;
-	}
-
-	microprog[0] = KING_CODE_BG0_CG_0;
-	king_disable_microprogram();
-	king_write_microprogram(microprog, 0, 16);
-	king_enable_microprogram();
+	king_setup_microprogram(0, 0);  // BG0 only: one 4-color CG read
 
 	tetsu_set_palette(0, 0x0088);
 	tetsu_set_palette(1, 0xE088);
@@ -128,9 +122,7 @@ int main(int argc, char *argv[])
 	king_set_kram_write(0, 1);
 
 	// Clear BG0's RAM
-	for(i = 0; i < 0x1E00; i++) {
-		king_kram_write(0);
-	}
+	king_kram_fill(0, 0x1E00);
 
         //
         // load font into video memory
@@ -168,6 +160,8 @@ int main(int argc, char *argv[])
 
 	vdc_setreg(VDC0, VDC_REG_CR, VDC_CR_BB);
 
+	build_raster_table();
+
         // Disable all interrupts before changing handlers.
         irq_set_mask(0x7F);
 
@@ -217,18 +211,18 @@ void printstr(const char* str, int x, int y, int tall)
 
 void printch(u32 sjis, u32 kram, int tall)
 {
-	u16 px;
+	u16 px[16];
 	int x, y;
 	u8* glyph = romfont_get(sjis, tall ? ROMFONT_ANK_8x16 : ROMFONT_ANK_8x8);
 	for(y = 0; y < (tall ? 16 : 8); y++) {
-		king_set_kram_write(kram + (y << 5), 1);
-		px = 0;
+		px[y] = 0;
 		for(x = 0; x < 8; x++) {
 			if((glyph[y] >> x) & 1) {
-				px |= 1 << (x << 1);
+				px[y] |= 1 << (x << 1);
 			}
 		}
-		king_kram_write(px);
 	}
+	king_set_kram_write(kram, 32);  // one glyph row per BG0 line
+	king_kram_write_block(px, tall ? 16 : 8);
 }
 
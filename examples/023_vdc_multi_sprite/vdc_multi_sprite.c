@@ -20,6 +20,7 @@ Copyright (C) 2011		Alex Marshall "trap15" <trap15@raidenii.net>
 #include <pcfx/king.h>
 #include <pcfx/tetsu.h>
 #include <pcfx/vdc.h>
+#include <pcfx/vdcalloc.h>
 
 void printch(u32 sjis, u32 kram, int tall);
 void printstr(const char* str, int x, int y, int tall);
@@ -37,7 +38,7 @@ const uint16_t spr_data[] = {
   0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000
 };
 
-const uint16_t sprite_image_load_addr = 0x4000;  // just a location in video memory
+uint16_t sprite_image_load_addr;  // given by the VRAM allocator
 
 // Each element will have a position (x,y) and a vector of movement (dx,dy)
 // - palette is so that we can have some color variance, but not expected to be extreme
@@ -54,7 +55,7 @@ typedef struct {
 
 element pixels[64];  // VDC can handle up to 64 sprites
 
-int x, y;
+u16 screen_xy[64][2];  // on-screen x/y of each sprite, sent with one call per frame
 
 ///////////////////////////////// Interrupt handler variables
 volatile int sda_frame_count = 0;
@@ -126,15 +127,11 @@ u32 pad;
 	if (pad & JOY_RUN)
 	    initialize_pixels();
 
-	vdc_set(VDC0);
 	for (i = 0; i < 63; i++)
 	{
 	    if (pixels[i].active == 0)
 	        continue;
 
-	    vdc_spr_set(i);
-
-
 	    pixels[i].x += pixels[i].dx;
 	    if ((pixels[i].x < 0x1f00) || (pixels[i].x > 0x14000)) {
 	        pixels[i].active = 0;
@@ -147,22 +144,22 @@ u32 pad;
 	    if (pixels[i].active != 0)
 	        pixels[i].dy += 0x10;
 
-	    x = (pixels[i].x >> 8);
-	    y = (pixels[i].y >> 8);
-
-	    vdc_spr_xy(x, y);
+	    screen_xy[i][0] = (pixels[i].x >> 8);
+	    screen_xy[i][1] = (pixels[i].y >> 8);
 	}
 
+	vdc_set(VDC0);
+	vdc_spr_xy_array(0, 63, &screen_xy[0][0], sizeof(screen_xy[0]));
+	vdc_spr_commit(VDC0);  // send this frame's positions in one burst
+
 	wait_vsync(0);
 }
 
 int main(int argc, char *argv[])
 {
 	int i;
-	u16 microprog[16];
 
-	vdc_init_5MHz(VDC0);
-	vdc_init_5MHz(VDC1);
+	vdcm_init_5MHz(VDC_MASK_BOTH);
 
 	king_init();
 	tetsu_init();
@@ -177,14 +174,7 @@ int main(int argc, char *argv[])
 	king_set_bg_mode(KING_BGMODE_4_PAL, 0, 0, 0);
 	king_set_kram_pages(0, 0, 0, 0);
 
-	for(i = 0; i < 16; i++) {
-		microprog[i] = KING_CODE_NOP;
-	}
-
-	microprog[0] = KING_CODE_BG0_CG_0;
-	king_disable_microprogram();
-	king_write_microprogram(microprog, 0, 16);
-	king_enable_microprogram();
+	king_setup_microprogram(0, 0);  // BG0 only: one 4-color CG read
 
 	tetsu_set_palette(0, 0x0088);
 	tetsu_set_palette(1, 0xE088);
@@ -213,19 +203,16 @@ int main(int argc, char *argv[])
 	king_set_kram_write(0, 1);
 
 	// Clear BG0's RAM
-	for(i = 0; i < 0x1E00; i++) {
-		king_kram_write(0);
-	}
+	king_kram_fill(0, 0x1E00);
 
 	// load sprite data
-	// -> Place at VRAM address set by sprite_image_load_addr
+	// -> The allocator picks a free, sprite-aligned VRAM address
 	//
-	vdc_set_vram_write(VDC0, sprite_image_load_addr);
-	for(i = 0; i < 8*4; i++) {
-		vdc_vram_write(VDC0, spr_data[i]); /* sprite is plus sign */
-	}
+	vdc_valloc_init(VDC0, 32*32);
+	sprite_image_load_addr = vdc_pattern_load(VDC0, spr_data, 8*4, VDC_VALLOC_SPRITE); /* sprite is plus sign */
 
 	vdc_set(VDC0);
+	vdc_spr_shadow(VDC0, 1);  // sprite updates go to RAM until vdc_spr_commit()
 
 	initialize_pixels();
 	for (i = 0; i < 63; i++) {
@@ -235,6 +222,7 @@ int main(int argc, char *argv[])
 			   VDC_SPR_PATTERN(sprite_image_load_addr),
 			   pixels[i].palette);
 	}
+	vdc_spr_commit(VDC0);
 
 	king_set_kram_write(0, 1);
 	printstr("VDC multi-sprite example", 5, 0x10, 1);
@@ -271,9 +259,6 @@ int main(int argc, char *argv[])
 	/* Now that the interrupt is set up, we can enable the hardware to produce it */
 	vdc_setreg(VDC0, VDC_REG_CR, (VDC_CR_SB|VDC_CR_IRQ_VC));  // Set Hu6270 SP to show, and VSYNC Interrupt
 
-	x = 0xA0;  // note that X-offsets are not 0-relative (0x20 is the left edge of the screen)
-	y = 0xC0;  // note that Y-offsets are not 0-relative (0x40 is the top edge of the screen)
-
 	while (1) {
 	    mainloop();
 	}
@@ -296,18 +281,18 @@ void printstr(const char* str, int x, int y, int tall)
 
 void printch(u32 sjis, u32 kram, int tall)
 {
-	u16 px;
+	u16 px[16];
 	int x, y;
 	u8* glyph = romfont_get(sjis, tall ? ROMFONT_ANK_8x16 : ROMFONT_ANK_8x8);
 	for(y = 0; y < (tall ? 16 : 8); y++) {
-		king_set_kram_write(kram + (y << 5), 1);
-		px = 0;
+		px[y] = 0;
 		for(x = 0; x < 8; x++) {
 			if((glyph[y] >> x) & 1) {
-				px |= 1 << (x << 1);
+				px[y] |= 1 << (x << 1);
 			}
 		}
-		king_kram_write(px);
 	}
+	king_set_kram_write(kram, 32);  // one glyph row per BG0 line
+	king_kram_write_block(px, tall ? 16 : 8);
 }
 
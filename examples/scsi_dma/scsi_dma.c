@@ -44,7 +44,6 @@ const u16 pornpal[] = {
 int main(int argc, char *argv[])
 {
 	int i;
-	u16 microprog[16];
 	u32 paddata = 0;
 	u32 lastpad = 0;
 
@@ -59,15 +58,7 @@ int main(int argc, char *argv[])
 	king_set_bg_mode(KING_BGMODE_16_PAL, 0, 0, 0);
 	king_set_kram_pages(0, 0, 0, 0);
 
-	for(i = 0; i < 16; i++) {
-		microprog[i] = KING_CODE_NOP;
-	}
-
-	microprog[0] = KING_CODE_BG0_CG_0;
-	microprog[1] = KING_CODE_BG0_CG_1;
-	king_disable_microprogram();
-	king_write_microprogram(microprog, 0, 16);
-	king_enable_microprogram();
+	king_setup_microprogram(0, 0);  // BG0 only: two 16-color CG reads
 
 	for(i = 0; i < 16; i++) {
 		tetsu_set_palette(i, pornpal[i]);
@@ -83,9 +74,7 @@ int main(int argc, char *argv[])
 	king_set_kram_read(0, 1);
 	king_set_kram_write(0, 1);
 	// Clear BG0's RAM
-	for(i = 0x0; i < 0x7800; i++) {
-		king_kram_write(0);
-	}
+	king_kram_fill(0, 0x7800);
 	king_set_kram_write(0, 1);
 	contrlr_pad_init(0);
 
@@ -156,19 +145,19 @@ void printstr(const char* str, int x, int y, int tall)
 
 void printch(u32 sjis, u32 kram, int tall)
 {
-	u16 px;
-	int x, y, l;
+	u16 px[2];
+	int x, y, l, i;
 	u8* glyph = romfont_get(sjis, tall ? ROMFONT_ANK_8x16 : ROMFONT_ANK_8x8);
 	for(y = 0; y < (tall ? 16 : 8); y++) {
-		king_set_kram_write(kram + (y << 6), 1);
-		for(l = 8-4; l >= 0; l -= 4) {
-			px = 0;
+		for(l = 8-4, i = 0; l >= 0; l -= 4, i++) {
+			px[i] = 0;
 			for(x = 0; x < 4; x++) {
 				if((glyph[y] >> (x+l)) & 1) {
-					px |= 1 << (x << 3);
+					px[i] |= 1 << (x << 3);
 				}
 			}
-			king_kram_write(px);
 		}
+		king_set_kram_write(kram + (y << 6), 1);
+		king_kram_write_block(px, 2);
 	}
 }
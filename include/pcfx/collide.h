@@ -0,0 +1,88 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+/*
+ * Box collisions between many objects, using a spatial hash.
+ */
+
+#ifndef _LIBPCFX_COLLIDE_H_
+#define _LIBPCFX_COLLIDE_H_
+
+#include <pcfx/types.h>
+
+// The VDC's own collision flag (VDC_STAT_CR) only tells about sprite 0, so
+// games test boxes themselves. Testing every pair is slow with many
+// objects; instead, each frame:
+// a) coll_begin(), then coll_add() for each object (or coll_add_sprite()
+//    to take the box from a sprite already set up with vdc_spr_*())
+// b) coll_pairs() for every overlapping pair, and/or coll_query() for the
+//    objects overlapping one box
+//
+// Objects are put in the cells of a grid (2^shift pixels square) that they
+// cover, so only objects sharing a cell are compared. Each pair is given
+// once, even when the two share several cells.
+//
+// Groups and masks choose which objects can hit each other: a and b hit if
+// (a.group & b.mask) or (b.group & a.mask) is non-zero.
+//
+
+#define COLL_MAX_OBJECTS   256     // Objects per frame
+#define COLL_MAX_CELLS     1024    // Object/cell entries per frame
+
+struct coll_hit {
+	u8 a, b;       // Object numbers from coll_add(), a < b
+};
+
+/* Start a new frame, forgetting all objects.
+ *
+ * shift: Grid cell size is (1 << shift) pixels; about the size of the
+ *        common objects works best (e.g. 5 for 32 pixels).
+ */
+void coll_begin(int shift);
+
+/* Add an object.
+ *
+ * x, y:  Top-left corner.
+ * w, h:  Size in pixels.
+ * group: What this object is (bits).
+ * mask:  What it collides with (bits).
+ * Returns the object number (0 ~ COLL_MAX_OBJECTS - 1), or -1 when full.
+ */
+int coll_add(int x, int y, int w, int h, u16 group, u16 mask);
+
+/* Add an object with the box of a sprite, in screen coordinates.
+ *
+ * Reads the sprite's position and size through vdc_set() / vdc_spr_set()
+ * and vdc_spr_get_*() (from RAM when the SATB shadow is on), so it leaves
+ * chip and spr as the current VDC and sprite.
+ *
+ * chip: Which VDC. (0 ~ 1)
+ * spr:  Sprite number. (0 ~ 63)
+ * Returns the object number, or -1 when full.
+ */
+int coll_add_sprite(int chip, int spr, u16 group, u16 mask);
+
+/* Find all overlapping pairs.
+ *
+ * hits: Filled in with the pairs.
+ * max:  Size of hits.
+ * Returns how many pairs were stored (at most max).
+ */
+int coll_pairs(struct coll_hit *hits, int max);
+
+/* Find the objects overlapping a box.
+ *
+ * mask: Only objects with a group bit in mask are given.
+ * ids:  Filled in with the object numbers.
+ * max:  Size of ids.
+ * Returns how many were stored (at most max).
+ */
+int coll_query(int x, int y, int w, int h, u16 mask, u8 *ids, int max);
+
+#endif
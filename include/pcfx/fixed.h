@@ -0,0 +1,122 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+/*
+ * 16.16 fixed-point math, tuned for the V810.
+ */
+
+#ifndef _LIBPCFX_FIXED_H_
+#define _LIBPCFX_FIXED_H_
+
+#include <pcfx/types.h>
+
+// The V810 'mul' instruction produces a full 64-bit product (the upper half
+// lands in r30), so a 16.16 multiply costs one multiply and a few shifts.
+// Division uses 'divu' for the integer part and, for divisors below 1.0,
+// a second 'divu' for the fraction.
+//
+// examples/012_fixed_bench times each routine against the equivalent V810
+// FPU instruction sequence (including the int<->float conversions), so the
+// faster option can be chosen per operation.  If an algorithm divides many
+// values by the same divisor, use fix16_recip() once and multiply instead.
+//
+// Angles are expressed in 1024 units per full circle.
+//
+
+
+typedef s32 fix16;                              // 16.16 signed fixed-point
+
+#define FIX16_ONE               0x10000
+#define FIX16_HALF              0x08000
+#define FIX16_MAX               0x7FFFFFFF
+#define FIX16_MIN               ((fix16)0x80000000)
+
+#define FIX16(x)                ((fix16)((x) * 65536.0))   // compile-time constants only
+#define FIX16_FROM_INT(i)       ((fix16)((i) << 16))
+#define FIX16_TO_INT(f)         ((f) >> 16)                 // rounds towards -infinity
+#define FIX16_ROUND(f)          (((f) + FIX16_HALF) >> 16)
+#define FIX16_FROM_24_8(f)      ((fix16)((f) << 8))         // 24.8 as in the examples
+#define FIX16_TO_24_8(f)        ((f) >> 8)
+
+#define FIX16_ANGLE_FULL        1024
+#define FIX16_ANGLE_QUARTER     256
+#define FIX16_DEG(d)            (((d) * FIX16_ANGLE_FULL) / 360)
+
+
+/* Multiply two fixed-point values.
+ *
+ * a, b:         Values to multiply.
+ * return value: a * b, truncated. Wraps if the result does not fit.
+ */
+fix16 fix16_mul(fix16 a, fix16 b);
+
+/* Divide two fixed-point values.
+ *
+ * a:            Dividend.
+ * b:            Divisor.
+ * return value: a / b, truncated towards zero. Saturates to FIX16_MAX or
+ *               FIX16_MIN on overflow or when b is 0.
+ */
+fix16 fix16_div(fix16 a, fix16 b);
+
+/* Reciprocal of a fixed-point value.
+ *
+ * Faster than fix16_div(FIX16_ONE, a): it is a single 32-bit divide.
+ *
+ * a:            Value (must not be within +/- 2/65536 of zero).
+ * return value: 1 / a. Saturates on overflow.
+ */
+fix16 fix16_recip(fix16 a);
+
+/* Square root of a fixed-point value.
+ *
+ * a:            Value.
+ * return value: sqrt(a), within 1 LSB of the nearest value (usually
+ *               exactly it). Returns 0 for a <= 0.
+ */
+fix16 fix16_sqrt(fix16 a);
+
+/* Sine and cosine, from a quarter-wave lookup table.
+ *
+ * angle:        1024 units per full circle. Any value is accepted; only
+ *               the low 10 bits are used.
+ * return value: sin/cos of angle (-FIX16_ONE ~ FIX16_ONE).
+ */
+fix16 fix16_sin(int angle);
+fix16 fix16_cos(int angle);
+
+/* Transform an array of 2D points by a 2x3 affine matrix.
+ *
+ *   x' = m[0] * x + m[1] * y + m[2]
+ *   y' = m[3] * x + m[4] * y + m[5]
+ *
+ * m:     2x3 matrix, row-major.
+ * src:   Array of (x, y) pairs.
+ * dst:   Output array of (x, y) pairs. May be the same as src.
+ * count: Number of points.
+ */
+void fix16_transform2(const fix16 *m, const fix16 *src, fix16 *dst, int count);
+
+/* Transform an array of 3D vectors by a 3x3 matrix.
+ *
+ * m:     3x3 matrix, row-major.
+ * src:   Array of (x, y, z) triples.
+ * dst:   Output array of (x, y, z) triples. May be the same as src.
+ * count: Number of vectors.
+ */
+void fix16_transform3(const fix16 *m, const fix16 *src, fix16 *dst, int count);
+
+/* Multiply two 3x3 matrices.
+ *
+ * a, b: 3x3 matrices, row-major.
+ * dst:  Output (a * b). Must not overlap a or b.
+ */
+void fix16_mat3_mul(const fix16 *a, const fix16 *b, fix16 *dst);
+
+#endif
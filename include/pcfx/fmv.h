@@ -0,0 +1,136 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+/*
+ * Full-motion video streaming from CD through KRAM to RAINBOW.
+ */
+
+#ifndef _LIBPCFX_FMV_H_
+#define _LIBPCFX_FMV_H_
+
+#include <pcfx/types.h>
+
+// A stream (built with tools/fmvpack.c) is a header followed by one packet
+// per frame: the frame's compressed picture, then its ADPCM audio, each
+// padded to whole 2048-byte sectors. The header lists the size of every
+// packet, so the player can read ahead without parsing the data.
+//
+// The player keeps two rings in KRAM, one for pictures and one for audio.
+// fmv_service(), called from the main loop, keeps the rings full with
+// SCSI DMA reads, without waiting for the drive. fmv_vblank(), called from
+// the VBlank interrupt, is the clock: when a frame is due, it has KING feed
+// its picture to RAINBOW and hands its audio to the audio function. If the
+// drive falls behind, late frames are skipped so the picture stays in time
+// with the sound.
+//
+// SCSI DMA writes to the SCSI page of KRAM, so the SCSI, RAINBOW and ADPCM
+// pages (king_set_kram_pages()) must all be the same.
+//
+// How to use:
+// a) set up RAINBOW output (tetsu_set_rainbow_palette(), priorities) and
+//    ADPCM
+// b) fmv_open() with the stream's LBA and the KRAM for the rings
+// c) fmv_set_audio() to start each frame's audio chunk
+// d) fmv_start(), then in the main loop: while(fmv_service(&f)) { ... }
+//    in the VBlank interrupt: fmv_vblank(&f);
+// e) if f.failed is set, the drive kept failing a read and playback stopped
+//
+// fmv_vblank() also times the waits on the drive, so the VBlank interrupt
+// must be running from fmv_start() on; a drive stuck for 3 seconds is
+// reset and the read tried again.
+//
+
+#define FMV_MAGIC        0x564D4650    // "PFMV"
+#define FMV_SECTOR       2048
+
+struct fmv_header {
+	u32 magic;               // FMV_MAGIC
+	u16 version;             // 1
+	u16 header_sectors;      // Sectors before the first packet
+	u32 frames;
+	u16 width, height;       // Picture size in pixels
+	u16 vblanks_per_frame;   // e.g. 4 for 15 frames/second
+	u16 audio_rate;          // adpcm_rate value for the audio
+	u16 max_video_sectors;   // Largest picture, in sectors
+	u16 max_audio_sectors;   // Largest audio chunk, in sectors
+	u32 reserved[2];
+	// 32 bytes; followed by u8 video_sectors, audio_sectors for each frame
+};
+
+/* Called when a frame's audio is due.
+ *
+ * kram:  KRAM address of the chunk.
+ * bytes: Size of the chunk (whole sectors).
+ * frame: Frame number.
+ */
+typedef void (*fmv_audio_fn)(u32 kram, u32 bytes, u32 frame);
+
+struct fmv {
+	struct fmv_header hdr;
+	const u8 *sizes;         // Sector counts, 2 per frame (from the header)
+	u32 lba;                 // LBA of the next packet to read
+	u32 video_kram, audio_kram;
+	int slots;               // Frames the rings hold
+	u32 video_slot_words, audio_slot_words;
+
+	u32 read_frame;          // Next frame to read
+	u32 shown_frame;         // Next frame to show
+	int read_part;           // 0 = picture, 1 = audio
+	int state;
+	int retries;             // Failed tries of the current read
+	int failed;              // 1 once a read has failed for good
+	vu32 waited;             // VBlanks spent waiting on the drive
+	int playing;
+	vu32 ticks;              // VBlanks since fmv_start()
+	u32 dropped;             // Frames skipped because they were late
+
+	fmv_audio_fn audio;
+};
+
+/* Read a stream's header and set up the player.
+ *
+ * f:          The player.
+ * lba:        First sector of the stream.
+ * table:      RAM for the header and size table: header_sectors * 2048
+ *             bytes (32 + 2 bytes per frame, rounded up to a sector).
+ * table_size: Size of table, in bytes.
+ * video_kram: KRAM address of the picture ring.
+ * audio_kram: KRAM address of the audio ring.
+ * slots:      Frames each ring holds (3 or more); the rings take
+ *             slots * max_video_sectors and slots * max_audio_sectors
+ *             sectors.
+ * Returns 1, or 0 if the header is bad, table is too small or slots is
+ * less than 3.
+ */
+int fmv_open(struct fmv *f, u32 lba, u8 *table, u32 table_size,
+             u32 video_kram, u32 audio_kram, int slots);
+
+/* Set the function that starts each frame's audio.
+ */
+void fmv_set_audio(struct fmv *f, fmv_audio_fn audio);
+
+/* Fill the rings before playing, then start the clock.
+ *
+ * Returns 1, or 0 if a read failed (see fmv_service()).
+ */
+int fmv_start(struct fmv *f);
+
+/* Keep reading; call often from the main loop.
+ *
+ * Returns 0 when the whole stream has been read and shown, or when a read
+ * has failed several times in a row; f->failed tells the two apart.
+ */
+int fmv_service(struct fmv *f);
+
+/* Advance the clock and show a frame when one is due; call from the
+ * VBlank interrupt, from fmv_start() on.
+ */
+void fmv_vblank(struct fmv *f);
+
+#endif
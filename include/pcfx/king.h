@@ -17,6 +17,7 @@ Copyright (C) 2011              Alex Marshall "trap15" <trap15@raidenii.net>
 #define _LIBPCFX_KING_H_
 
 #include <pcfx/types.h>
+#include <pcfx/fixed.h>
 
 /* KING microprogram opcode generator.
  *
@@ -182,10 +183,25 @@ typedef enum {
 	KING_BG3    = 4, /* Background 3 */
 } king_bg;
 
-/* Initialize KING.
+/* Initialize KING, clearing all of KRAM.
  */
 void king_init(void);
 
+/* king_init_ex() flags: which 64K-word blocks of KRAM to clear.
+ */
+#define KING_INIT_CLEAR_BLOCK(page, addr)  (1 << (((page) << 2) | ((addr) >> 16)))
+#define KING_INIT_CLEAR_PAGE0  0x0F
+#define KING_INIT_CLEAR_PAGE1  0xF0
+#define KING_INIT_CLEAR_ALL    0xFF
+#define KING_INIT_NOCLEAR      0
+
+/* Initialize KING, clearing only some of KRAM (or none of it).
+ *
+ * flags: KING_INIT_CLEAR_ALL, KING_INIT_NOCLEAR, KING_INIT_CLEAR_PAGEn, or
+ *        KING_INIT_CLEAR_BLOCK()s ORed together.
+ */
+void king_init_ex(int flags);
+
 /* Set KRAM read address.
  *
  * addr: New read address.
@@ -212,6 +228,37 @@ u16 king_kram_read(void);
  */
 void king_kram_write(u16 data);
 
+/* Write many words to KRAM, at the address set by king_set_kram_write().
+ *
+ * src:    Data to write.
+ * nwords: How many 16bit words.
+ */
+void king_kram_write_block(const u16 *src, int nwords);
+
+/* Write the same word many times to KRAM, at the address set by
+ * king_set_kram_write().
+ *
+ * data:   Value to write.
+ * nwords: How many 16bit words.
+ */
+void king_kram_fill(u16 data, int nwords);
+
+/* Clear part of KRAM. Leaves the write address after the cleared words,
+ * with an increment of 1.
+ *
+ * page:   KRAM page. (0 ~ 1)
+ * addr:   First word to clear.
+ * nwords: How many 16bit words.
+ */
+void king_kram_clear(int page, u32 addr, int nwords);
+
+/* Read many words from KRAM, at the address set by king_set_kram_read().
+ *
+ * dst:    Where to put the data.
+ * nwords: How many 16bit words.
+ */
+void king_kram_read_block(u16 *dst, int nwords);
+
 /* Set the KRAM page for various peripherals.
  *
  * scsi:    The KRAM page used for SCSI. (0 ~ 1)
@@ -231,6 +278,12 @@ void king_set_kram_pages(u8 scsi, u8 bg, u8 rainbow, u8 adpcm);
 void king_set_bg_mode(king_bgmode bg0, king_bgmode bg1, king_bgmode bg2,
 			king_bgmode bg3);
 
+/* Get the color modes last set with king_set_bg_mode().
+ *
+ * return: BG0 mode in bits 0-3, BG1 in bits 4-7, and so on.
+ */
+u16 king_get_bg_mode(void);
+
 /* Set priorities for the backgrounds.
  *
  * bg0:   Priority for background 0.
@@ -293,5 +346,137 @@ void king_enable_microprogram(void);
  */
 void king_disable_microprogram(void);
 
+/* Have KING feed compressed picture data from KRAM to RAINBOW.
+ *
+ * kram:   KRAM address of the data (in the RAINBOW page).
+ * line:   Display line where the picture starts.
+ * blocks: Height of the picture, in 16-line blocks.
+ * irq:    Non-zero to raise the KING IRQ when the transfer is done.
+ */
+void king_rainbow_transfer(u32 kram, int line, int blocks, int irq);
+
+/* Stop feeding RAINBOW.
+ */
+void king_rainbow_stop(void);
+
+/* BG0 rotation/scaling coefficients, as KING takes them.
+ *
+ * A BG0 pixel at screen offset (dx, dy) from the center shows BG pixel
+ *   x = a * dx + b * dy + cx
+ *   y = c * dx + d * dy + cy
+ * a ~ d are 8.8 fixed point (0x100 = 1.0).
+ */
+struct king_affine {
+	s16 a, b, c, d;
+	s16 cx, cy;
+};
+
+/* Set the BG0 rotation/scaling coefficients. Rotation must be enabled
+ * with king_set_bg_prio() (bgrot) and in the microprogram.
+ *
+ * a, b, c, d: Coefficients, truncated to KING's 8.8 format.
+ * cx, cy:     Center of rotation, in BG pixels.
+ */
+void king_set_bg0_affine(fix16 a, fix16 b, fix16 c, fix16 d, int cx, int cy);
+
+/* Set the BG0 rotation/scaling coefficients from a struct king_affine.
+ * Fast enough for a raster IRQ.
+ */
+void king_load_bg0_affine(const struct king_affine *m);
+
+/* Get the KING register last selected by these functions.
+ *
+ * An IRQ handler which touches KING registers should fetch this first and
+ * give it to king_set_regnum() before returning. Selections made by the
+ * SCSI functions are not seen.
+ */
+int king_get_last_regnum(void);
+
+/* Select a KING register without writing to it.
+ *
+ * reg: Register number, usually from king_get_last_regnum().
+ */
+void king_set_regnum(int reg);
+
+/* Write a 16-bit KING register at once, even with queuing on.
+ *
+ * reg:   Register number.
+ * value: The value to write.
+ */
+void king_write_reg(int reg, u16 value);
+
+// Queued register writes
+//
+// With queuing on, king_set_kram_pages(), king_set_bg_mode(),
+// king_set_bg_prio(), king_set_bg_size(), king_set_bat_cg_addr(),
+// king_set_scroll() and king_set_bg0_affine() don't write KING registers;
+// they keep the value in RAM, and king_queue_flush(), called from the
+// VBlank interrupt, writes them all in one loop. Setting a register again
+// before the flush only replaces the value kept. So the game can change
+// KING state at any point of the frame, and it all shows from the next
+// frame on.
+//
+// The other functions (KRAM access, microprogram, RAINBOW,
+// king_load_bg0_affine()) still write at once. A VBlank handler which
+// uses the setters itself (e.g. king_bgbuf_vblank()) should call
+// king_queue_flush() after them.
+//
+
+/* Turn queuing on or off. Turning it off flushes the queue.
+ *
+ * on: Non-zero to queue the setters' writes.
+ */
+void king_set_queued(int on);
+
+/* Write the queued registers; call from the VBlank interrupt handler.
+ *
+ * Reselects the KING register that was selected when the IRQ came in.
+ */
+void king_queue_flush(void);
+
+// Microprogram generator
+//
+// Each background needs some KRAM reads for every 8 pixels, and KING has 8
+// read slots for them (the first 8 microprogram opcodes):
+//
+//   4 colors: 1     16 colors: 2     256 colors: 4     64K/16M colors: 8
+//   plus 1 in BAT mode, for the BAT entry
+//
+// So a 64K/16M BAT background (including the EXTDOT modes) needs 9 and
+// can't be shown this way; it is always reported as left out.
+//
+// These build a microprogram giving each shown background its reads, in
+// order BG0 ~ BG3. A background that doesn't fit in the slots left is
+// left out, and reported.
+//
+#define KING_MP_SLOTS   8
+
+struct king_mp_report {
+	int slots_used;     /* Slots given to backgrounds. */
+	int slots_needed;   /* Slots all shown backgrounds would need. */
+	int dropped;        /* Bit n set: BGn didn't fit, and won't show. */
+};
+
+/* Build a microprogram for some background modes.
+ *
+ * prog:   16 opcodes, filled in (unused ones are KING_CODE_NOP).
+ * modes:  BG0 mode in bits 0-3, BG1 in bits 4-7, and so on, as given
+ *         by king_get_bg_mode().
+ * rotate: Non-zero if BG0 is rotated/scaled.
+ * report: Filled in with the slot usage; may be NULL.
+ * return: 1 if all backgrounds fit, 0 if some were left out.
+ */
+int king_build_microprogram(u16 *prog, u16 modes, int rotate,
+			struct king_mp_report *report);
+
+/* Build the microprogram for the modes last set with king_set_bg_mode(),
+ * and load and enable it.
+ *
+ * rotate: Non-zero if BG0 is rotated/scaled.
+ * report: Filled in with the slot usage; may be NULL.
+ * return: 1 if all backgrounds fit, 0 if some were left out.
+ */
+int king_setup_microprogram(int rotate, struct king_mp_report *report);
+
 #endif
 
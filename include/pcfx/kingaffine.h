@@ -0,0 +1,65 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+/*
+ * Per-line BG0 rotation/scaling for KING.
+ */
+
+#ifndef _LIBPCFX_KINGAFFINE_H_
+#define _LIBPCFX_KINGAFFINE_H_
+
+#include <pcfx/types.h>
+#include <pcfx/fixed.h>
+#include <pcfx/king.h>
+#include <pcfx/kingline.h>
+
+// The tables are run by <pcfx/kingline.h> (channel KING_LINE_AFFINE),
+// timed by the VDC raster counter: each line with an entry raises a VDC
+// IRQ, which loads that entry's coefficients into KING. With a different
+// scale on every line, BG0 becomes a ground plane seen in perspective.
+//
+// How to use:
+// a) enable BG0 rotation (king_set_bg_prio() bgrot, and
+//    king_setup_microprogram(1, ...))
+// b) set up king_line_irq() as told in <pcfx/kingline.h>
+// c) fill a table of struct king_affine (king_affine_rotscale() for each
+//    line), then king_affine_show(); wait for king_affine_pending() to be
+//    0 before filling the table shown before it again
+//
+// Each entry costs 6 KING register writes.
+//
+
+/* Show a table from the next VBlank on; see king_line_show().
+ *
+ * Entry 0 is loaded at VBlank, for the lines down to first; entry n is
+ * loaded during line first + n - 1, for line first + n on.
+ * lines: The table (not copied; keep it until it is replaced).
+ * first: Display line of entry 0.
+ * count: Entries in the table; 0 stops the table, leaving BG0 as the
+ *        last entry set it.
+ */
+void king_affine_show(const struct king_affine *lines, int first, int count);
+
+/* Returns 1 while the table last given to king_affine_show() is waiting
+ * for VBlank, so the one it replaces is still in use.
+ */
+int king_affine_pending(void);
+
+/* Fill in coefficients for a rotation and a scale.
+ *
+ * m:       Filled in. Coefficients beyond KING's range are clamped.
+ * angle:   Rotation, 1024 units per full circle.
+ * scale_x: Horizontal zoom (FIX16_ONE = 1:1, bigger = closer).
+ * scale_y: Vertical zoom.
+ * cx, cy:  Center of rotation, in BG pixels.
+ */
+void king_affine_rotscale(struct king_affine *m, int angle, fix16 scale_x,
+                          fix16 scale_y, int cx, int cy);
+
+#endif
@@ -0,0 +1,92 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+/*
+ * Double-buffered KING backgrounds.
+ */
+
+#ifndef _LIBPCFX_KINGBUF_H_
+#define _LIBPCFX_KINGBUF_H_
+
+#include <pcfx/types.h>
+#include <pcfx/king.h>
+
+// KRAM writes and king_set_bat_cg_addr() take effect at once, so changing
+// a background while it is shown tears. Here each background has two
+// BAT/CG areas: one shown (front) and one being drawn (back). When the
+// back one is finished, king_bgbuf_flip() asks for the two to be swapped;
+// the swap is done by king_bgbuf_vblank() in the VBlank interrupt, by
+// rewriting the BAT/CG address registers. Drawing can take as many frames
+// as needed.
+//
+// How to use:
+// a) king_bgbuf_alloc() (or king_bgbuf_init() with areas placed by hand)
+//    for each double-buffered background; buffer 0 is shown
+// b) call king_bgbuf_vblank() from the VBlank interrupt handler
+// c) draw into KING_BGBUF_BACK_BAT() / KING_BGBUF_BACK_CG(), then
+//    king_bgbuf_flip(); before drawing the next picture, king_bgbuf_wait()
+//    (until the VBlank, the back buffer is the one about to be shown)
+//
+// The back buffer holds the picture from two flips ago, not the last one.
+// With king_set_queued() on, the flips are queued too: call
+// king_queue_flush() after king_bgbuf_vblank().
+//
+
+struct king_bgbuf {
+	king_bg bg;
+	u32 bat[2], cg[2];      // KRAM addresses of both buffers (page in bit 31)
+	volatile int front;     // Buffer being shown (0 ~ 1)
+	volatile int flip;      // Non-zero: swap at the next VBlank
+};
+
+#define KING_BGBUF_BACK_BAT(b)   ((b)->bat[(b)->front ^ 1])
+#define KING_BGBUF_BACK_CG(b)    ((b)->cg[(b)->front ^ 1])
+
+/* Set up a double-buffered background, and show buffer 0.
+ *
+ * b:          The buffer pair (kept; it must stay valid).
+ * bg:         Which background.
+ * bat0, cg0:  KRAM addresses of buffer 0 (1K-word aligned).
+ * bat1, cg1:  KRAM addresses of buffer 1.
+ */
+void king_bgbuf_init(struct king_bgbuf *b, king_bg bg, u32 bat0, u32 cg0,
+                     u32 bat1, u32 cg1);
+
+/* Set up a double-buffered background with areas from king_kalloc().
+ *
+ * bat_words: BAT size in words (0 for a mode without BAT).
+ * cg_words:  CG size in words.
+ * Returns 1, or 0 if KRAM is full (nothing is left allocated).
+ */
+int king_bgbuf_alloc(struct king_bgbuf *b, king_bg bg, int bat_words,
+                     int cg_words);
+
+/* Stop handling a background (its current buffer stays shown).
+ */
+void king_bgbuf_remove(struct king_bgbuf *b);
+
+/* Show the back buffer from the next VBlank on.
+ */
+void king_bgbuf_flip(struct king_bgbuf *b);
+
+/* Returns 1 while a flip is waiting for VBlank.
+ */
+int king_bgbuf_flipping(const struct king_bgbuf *b);
+
+/* Wait until a flip is done. IRQs must be enabled.
+ */
+void king_bgbuf_wait(const struct king_bgbuf *b);
+
+/* Do the flips asked for; call from the VBlank interrupt handler.
+ *
+ * Reselects the KING register that was selected when the IRQ came in.
+ */
+void king_bgbuf_vblank(void);
+
+#endif
@@ -0,0 +1,88 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+/*
+ * Per-line KING background tables: scroll for BG0 ~ BG3, and BG0
+ * rotation/scaling (see <pcfx/kingaffine.h>).
+ */
+
+#ifndef _LIBPCFX_KINGLINE_H_
+#define _LIBPCFX_KINGLINE_H_
+
+#include <pcfx/types.h>
+#include <pcfx/king.h>
+
+// KING has no raster interrupt of its own, so the VDC raster counter (RCR)
+// gives the timing: king_line_irq() is called on each line where some
+// table has an entry, and writes it to KING. Per-line scroll gives
+// heat-haze, water and parallax on the KING layers.
+//
+// There is a table for each kind of write (channel). A table is an array
+// with one entry per line; it is not copied. The table given to
+// king_line_show() is used from the next VBlank on, so one table can be
+// filled while the other is shown.
+//
+// How to use:
+// a) on one VDC, enable the VBlank and raster IRQs (VDC_CR_IRQ_VC |
+//    VDC_CR_IRQ_RC), and call king_line_irq() from the VDC interrupt
+//    handler with the status read from vdc_status(). This uses the VDC's
+//    RCR, so that VDC can't also have vdc_raster tables.
+// b) fill a table, then king_scroll_show() (or king_affine_show());
+//    wait for king_scroll_pending() to be 0 before filling the table
+//    shown before it again
+//
+// Each line with entries costs an IRQ; a scroll entry is 2 KING register
+// writes. The SCSI functions select KING registers without going through
+// king_set_regnum(), so they must not be used while tables are shown.
+//
+
+#define KING_LINE_SCROLL(n)   (n)     // Scroll of BGn (0 ~ 3)
+#define KING_LINE_AFFINE      4       // BG0 rotation/scaling
+#define KING_LINE_CHANNELS    5
+
+/* Scroll table entry: as given to king_set_scroll().
+ */
+struct king_scroll_line {
+	s16 x, y;
+};
+
+/* Show a table from the next VBlank on.
+ *
+ * Entry 0 is written at VBlank, for the lines down to first; entry n is
+ * written during line first + n - 1, for line first + n on.
+ * channel: KING_LINE_SCROLL(n) or KING_LINE_AFFINE.
+ * lines:   The table (struct king_scroll_line or struct king_affine;
+ *          not copied, keep it until it is replaced).
+ * first:   Display line of entry 0.
+ * count:   Entries in the table; 0 stops the table, leaving the
+ *          registers as its last entry set them.
+ */
+void king_line_show(int channel, const void *lines, int first, int count);
+
+/* Returns 1 while the table last given to king_line_show() for a channel
+ * is waiting for VBlank, so the one it replaces is still in use.
+ */
+int king_line_pending(int channel);
+
+/* Show a scroll table for a background (BG0SUB is not allowed).
+ */
+void king_scroll_show(king_bg bg, const struct king_scroll_line *lines,
+                      int first, int count);
+int king_scroll_pending(king_bg bg);
+
+/* Service the tables from the VDC interrupt handler.
+ *
+ * Handles VDC_STAT_RR and VDC_STAT_VD, and reselects the VDC and KING
+ * registers that were selected when the IRQ came in.
+ * chip:   Which VDC raised the interrupt. (0 ~ 1)
+ * status: Value returned by vdc_status().
+ */
+void king_line_irq(int chip, u16 status);
+
+#endif
@@ -0,0 +1,96 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+/*
+ * Scrolling KING BAT-mode backgrounds over maps larger than their BAT.
+ */
+
+#ifndef _LIBPCFX_KINGSCROLL_H_
+#define _LIBPCFX_KINGSCROLL_H_
+
+#include <pcfx/types.h>
+#include <pcfx/king.h>
+
+// This is the KING version of <pcfx/vdcscroll.h>. The BAT of a
+// background in a KING_BGMODE_BAT mode is used as a ring: map tile
+// (col, row) is kept at BAT position (col % BAT width, row % BAT height),
+// and KING wraps around the background by itself when scrolling. When the
+// view moves onto a new tile column or row, only that column or row is
+// written to KRAM; columns are written with the KRAM write increment set
+// to the BAT width. Only the BAT has to fit in KRAM, not the whole map.
+//
+// How to use:
+// a) set the background up: king_set_bg_mode() with a BAT mode,
+//    king_set_bg_size(), king_set_bat_cg_addr(), and its CG
+// b) king_scroller_init() with the same BAT address and size, then give
+//    a map with king_scroller_set_map() or a fetch function (e.g. one
+//    decompressing chunks) with king_scroller_set_fetch()
+// c) king_scroller_redraw() once, then king_scroller_move() each frame
+//    (in VBlank, or with king_set_queued() on)
+//
+// The BAT must be at least one tile wider and taller than the view.
+//
+
+/* Fetch n BAT words of the map, starting at map tile (col, row), going
+ * down the column if vertical is 1, along the row if it is 0.
+ * Tiles outside the map can be given any value.
+ */
+typedef void (*king_scroller_fetch)(void *user, int col, int row, int n,
+                                    int vertical, u16 *out);
+
+struct king_scroller {
+	king_bg bg;
+	u32 bat;                    // KRAM address of the BAT (page in bit 31)
+	int bat_w, bat_h;           // BAT size in tiles
+	int cols, rows;             // Tiles kept up to date (view + 1)
+	int col0, row0;             // Map tile at the top-left of that area
+	int x, y;                   // Scroll position, in pixels
+
+	const u16 *map;             // RAM map of BAT words, row by row
+	int map_w, map_h;           // Its size in tiles
+	king_scroller_fetch fetch;  // Used instead when map is NULL
+	void *user;
+};
+
+/* Set up a scroller.
+ *
+ * s:      The scroller.
+ * bg:     Which background (BG0SUB is not allowed).
+ * bat:    KRAM address of its BAT, with the page in bit 31.
+ * h, w:   The sizes given to king_set_bg_size() for it.
+ * view_w: Width of the display, in pixels.
+ * view_h: Height of the display, in pixels.
+ * Returns 1, or 0 if the BAT is too small for the view.
+ */
+int king_scroller_init(struct king_scroller *s, king_bg bg, u32 bat,
+                       king_bgsize h, king_bgsize w, int view_w, int view_h);
+
+/* Use a map in RAM. Tiles outside it are written as 0.
+ *
+ * map:   BAT words, row by row.
+ * w, h:  Size of the map in tiles.
+ */
+void king_scroller_set_map(struct king_scroller *s, const u16 *map, int w, int h);
+
+/* Use a function to get tiles (e.g. to decompress them).
+ */
+void king_scroller_set_fetch(struct king_scroller *s, king_scroller_fetch fetch,
+                             void *user);
+
+/* Write the whole visible area for scroll position (x, y), and scroll there.
+ */
+void king_scroller_redraw(struct king_scroller *s, int x, int y);
+
+/* Scroll to (x, y), writing only the tiles which come into view.
+ *
+ * Jumps further than the view size are done with king_scroller_redraw().
+ */
+void king_scroller_move(struct king_scroller *s, int x, int y);
+
+#endif
@@ -0,0 +1,92 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+/*
+ * KING KRAM allocator.
+ */
+
+#ifndef _LIBPCFX_KRAMALLOC_H_
+#define _LIBPCFX_KRAMALLOC_H_
+
+#include <pcfx/types.h>
+
+// KRAM has two pages of 256K words. The SCSI, BG, RAINBOW and ADPCM units
+// each read or write only the page chosen for them by king_set_kram_pages(),
+// so every area is allocated in the page of the unit that will use it.
+//
+// Areas are handed out in 1K-word blocks, which is also the unit of the
+// BAT/CG addresses given to king_set_bat_cg_addr().
+//
+// Addresses returned have the page in bit 31, as king_set_kram_read() and
+// king_set_kram_write() expect:
+//
+//   u32 cg = king_kalloc(KING_KRAM_BG, 256*256/2, 0);
+//   king_set_kram_write(cg, 1);
+//   king_kram_write_block(pixels, 256*256/2);
+//   king_set_bat_cg_addr(KING_BG0, 0, KING_KRAM_BLOCK(cg));
+//
+
+typedef enum {
+	KING_KRAM_SCSI    = 0,   /* SCSI DMA targets */
+	KING_KRAM_BG      = 1,   /* BAT and CG of the backgrounds */
+	KING_KRAM_RAINBOW = 2,   /* RAINBOW (video decompression) buffers */
+	KING_KRAM_ADPCM   = 3,   /* ADPCM sample rings */
+	KING_KRAM_USES    = 4,
+} king_kram_use;
+
+#define KING_KALLOC_NONE        0xFFFFFFFF     // Returned when there is no room
+#define KING_KRAM_BLOCK_WORDS   1024
+
+#define KING_KRAM_PAGE(a)       ((a) >> 31)
+#define KING_KRAM_ADDR(a)       ((a) & 0x3FFFF)
+#define KING_KRAM_BLOCK(a)      (((a) >> 10) & 0xFF)   // For king_set_bat_cg_addr()
+
+struct king_kalloc_stats {
+	int used[2];                    // Words allocated in each page
+	int peak[2];                    // Most words ever allocated in each page
+	int largest_free[2];            // Biggest free area in each page, in words
+	int use_words[KING_KRAM_USES];  // Words allocated for each unit
+	int use_peak[KING_KRAM_USES];   // Most words ever allocated for each unit
+};
+
+/* Set the pages of the KRAM users (with king_set_kram_pages()) and mark
+ * all of KRAM free.
+ *
+ * scsi, bg, rainbow, adpcm: KRAM page for each. (0 ~ 1)
+ */
+void king_kalloc_init(u8 scsi, u8 bg, u8 rainbow, u8 adpcm);
+
+/* Mark an area as used, for things placed by hand.
+ *
+ * addr:  KRAM address, with the page in bit 31; rounded down to a block.
+ * words: Size; rounded up to a block.
+ */
+void king_kalloc_reserve(u32 addr, int words);
+
+/* Allocate KRAM in the page of a unit.
+ *
+ * use:   Which unit the area is for.
+ * words: Size, in words.
+ * align: Alignment in words; 0 or up to 1024 means one block, larger
+ *        values must be a power of two.
+ * Returns the KRAM address, or KING_KALLOC_NONE.
+ */
+u32 king_kalloc(king_kram_use use, int words, int align);
+
+/* Free KRAM from king_kalloc().
+ *
+ * use, words: As given to king_kalloc().
+ */
+void king_kfree(king_kram_use use, u32 addr, int words);
+
+/* Get the current and peak usage.
+ */
+void king_kalloc_stats(struct king_kalloc_stats *stats);
+
+#endif
@@ -0,0 +1,81 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+/*
+ * Metasprites: characters made of many VDC sprites.
+ */
+
+#ifndef _LIBPCFX_METASPR_H_
+#define _LIBPCFX_METASPR_H_
+
+#include <pcfx/types.h>
+#include <pcfx/vdc.h>
+
+// Metasprites are built from a text file by tools/metaspr, which outputs a
+// bank (as a C array or a binary file) laid out as:
+//
+//   u16 count;                   number of metasprites
+//   u16 offset[count];           byte offset of each one from the bank start
+//   then for each metasprite:
+//     u16 parts; u16 pad;
+//     struct vdc_metaspr_part part[parts];
+//
+// Each part has its offset both as drawn and as drawn flipped, so flipping
+// at runtime costs nothing but picking the other pair and toggling the
+// invert bits.
+//
+// How to use:
+// a) load the patterns (e.g. with vdc_pattern_load()), then
+//    vdc_metaspr_bank() with the bank and VDC_SPR_PATTERN() of their address
+// b) each frame: vdc_metaspr_begin(), vdc_metaspr_draw() for each
+//    character, vdc_metaspr_end()
+// c) with the SATB shadow on, vdc_spr_commit() afterwards
+//
+
+#define VDC_METASPR_FLIP_X     VDC_SPR_X_INVERT
+#define VDC_METASPR_FLIP_Y     VDC_SPR_Y_INVERT
+#define VDC_METASPR_PAL(pal)   ((pal) & 0xF)     // Added to each part's palette
+
+struct vdc_metaspr_part {
+	s16 dx, dy;              // Offset of the part's top-left from the anchor
+	s16 dx_flip, dy_flip;    // The same, when flipped horizontally/vertically
+	u16 pattern;             // Added to the bank's pattern base
+	u16 ctrl;                // Size, priority, palette and invert bits
+};
+
+/* Select the bank used by vdc_metaspr_draw().
+ *
+ * bank:    Output of tools/metaspr.
+ * pattern: VDC_SPR_PATTERN() of the VRAM address its patterns were loaded to.
+ */
+void vdc_metaspr_bank(const u16 *bank, u16 pattern);
+
+/* Start placing metasprites in a VDC's SATB.
+ *
+ * chip:  Which VDC. (0 ~ 1)
+ * first: First SATB entry to use; entries before it are left alone.
+ */
+void vdc_metaspr_begin(int chip, int first);
+
+/* Draw one metasprite at the next free SATB entries, in one burst.
+ *
+ * chip:  Which VDC. (0 ~ 1)
+ * id:    Metasprite number in the bank.
+ * x, y:  Anchor position, in SATB coordinates (as for vdc_spr_create()).
+ * flags: VDC_METASPR_FLIP_X, VDC_METASPR_FLIP_Y, VDC_METASPR_PAL().
+ * Returns the number of sprites used; fewer than the metasprite has if
+ * the SATB ran out.
+ */
+int vdc_metaspr_draw(int chip, int id, int x, int y, int flags);
+
+/* Hide the entries used before the last vdc_metaspr_begin() but not since.
+ */
+void vdc_metaspr_end(int chip);
+
+#endif
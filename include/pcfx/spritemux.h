@@ -0,0 +1,77 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+/*
+ * Sprite multiplexer: more logical sprites than the VDC SATBs can hold.
+ */
+
+#ifndef _LIBPCFX_SPRITEMUX_H_
+#define _LIBPCFX_SPRITEMUX_H_
+
+#include <pcfx/types.h>
+#include <pcfx/vdc.h>
+
+// Each HuC6270 shows at most 64 sprites, and at most 16 sprite cells
+// (16 pixels wide each) on one line; the 17th raises VDC_STAT_OR and is
+// not drawn.
+//
+// The SATB is only copied into the VDC during VBlank, so entries cannot be
+// reused further down the same frame. Instead, each frame the multiplexer:
+// a) sorts the logical sprites by Y,
+// b) places them, in that order, in the SATB of VDC 0 and then VDC 1,
+//    skipping a sprite when any of its lines is already full on that VDC,
+// c) starts next frame's pass at the first sprite it had to leave out,
+//    so crowded areas flicker instead of always losing the same sprites.
+//
+// Sprites are written with vdc_spr_update_array(); with the SATB shadow on
+// (vdc_spr_shadow()), call vdc_spr_commit() for each VDC afterwards.
+//
+// VDC 1 sprites use VDC 1's palettes, patterns and layer priority, so for
+// two VDCs the same patterns must be loaded in both VRAMs.
+//
+
+#define VDC_MUX_MAX      256     // Logical sprites per update
+
+struct vdc_mux_sprite {
+	u16 x;         // As in the SATB: screen X + 32
+	u16 y;         // As in the SATB: screen Y + 64
+	u16 pattern;
+	u16 ctrl;      // Size bits decide how many lines/cells it uses
+};
+
+struct vdc_mux_stats {
+	int shown;          // Placed in a SATB this frame
+	int dropped;        // Left out this frame (too many on a line, or SATBs full)
+	int offscreen;      // Not placed because they can't be seen
+	int worst_line;     // Screen line with the most sprites left out (-1 = none)
+};
+
+/* Set up the multiplexer.
+ *
+ * chips: How many VDCs to spread sprites on: 1 (VDC 0) or 2 (VDC 0 and 1).
+ */
+void vdc_mux_init(int chips);
+
+/* Place this frame's sprites in the SATB(s).
+ *
+ * list:  Logical sprites; their order only matters for sprites with the
+ *        same Y.
+ * count: How many (up to VDC_MUX_MAX).
+ * stats: Filled in with this frame's results; may be NULL.
+ */
+void vdc_mux_update(const struct vdc_mux_sprite *list, int count,
+                    struct vdc_mux_stats *stats);
+
+/* Number of sprites left out on a screen line by the last update.
+ *
+ * line: Screen line (0 ~ 255).
+ */
+int vdc_mux_line_drops(int line);
+
+#endif
@@ -40,6 +40,9 @@ Copyright (C) 2011                           Nodtveidt <david@eponasoft.com>
 // is one reason why the multi-bitfield registers don't have direct-setting
 // functions (the origianl version of liberis assumed that they were indeed
 // readable and tried to set sub-bitfields, resulting in bad settings).
+// Instead, the library keeps a copy in RAM of every value it writes to a
+// register; vdc_getreg() reads it back, and vdc_cr_set_bits() and
+// vdc_cr_clear_bits() change parts of CR safely.
 //
 // Remember to set up interrupt handling in your program before setting
 // any of these registers to fire interrupts.
@@ -134,9 +137,28 @@ typedef enum {
         VDC1
 } VDCNUM;
 
+// Chip masks for the vdcm_*() functions
+#define VDC_MASK_0      1
+#define VDC_MASK_1      2
+#define VDC_MASK_BOTH   (VDC_MASK_0 | VDC_MASK_1)
+
 
 
 // General
+//
+// vdc_init_xMHz() sets the display timing (display off), then clears VRAM
+// with the VDC's own VRAM-VRAM DMA, with CPU IRQs masked until it is done.
+// The clear takes about 2 frames. If a VDC doesn't report the end of its
+// DMA, init gives up waiting after 5 frames (up to 2 x 5 for both chips
+// in vdcm_init_xMHz()), waits for the DMA to stop, and clears by the CPU;
+// IRQs stay masked all that time.
+// ORing VDC_INIT_NOCLEAR into chip (or into the mask for vdcm_init_xMHz())
+// skips the clear, for when all of VRAM that is used will be written
+// anyway. The RAM SATB is still zeroed, and all of it is marked dirty,
+// so the first vdc_spr_commit() overwrites the sprites left in VRAM.
+//
+#define VDC_INIT_NOCLEAR   0x100
+
 void vdc_init_5MHz(int chip);
 void vdc_init_7MHz(int chip);
 
@@ -166,6 +188,62 @@ u16 vdc_spr_get_pattern(void);
 u16 vdc_spr_get_ctrl(void);
 u16 vdc_spr_get_pal(void);
 
+// Shadowed sprites
+//
+// With the shadow on, the vdc_spr_*() functions above work on a copy of the
+// SATB kept in RAM instead of VRAM, and remember which entries they changed.
+// vdc_spr_commit() then sends the changed range to VRAM in a single burst
+// (setting the write address once), to be picked up by the next SATB DMA.
+// Call it once per frame, after all sprite updates.
+//
+
+/* Turn the RAM copy of the SATB on or off.
+ *
+ * Turning it on loads the RAM copy from the SATB currently in VRAM.
+ * chip: Which VDC. (0 ~ 1)
+ * on:   1 = sprite functions use RAM, 0 = sprite functions use VRAM.
+ */
+void vdc_spr_shadow(int chip, int on);
+
+/* Send the modified part of the RAM copy of the SATB to VRAM.
+ *
+ * Does nothing if no sprite was changed since the last commit.
+ * chip: Which VDC. (0 ~ 1)
+ */
+void vdc_spr_commit(int chip);
+
+// Batched sprite updates
+//
+// These write many consecutive SATB entries in one call. They go to the RAM
+// copy when the shadow is on; otherwise they write VRAM directly.
+//
+struct vdc_sprite {
+	u16 y;
+	u16 x;
+	u16 pattern;
+	u16 ctrl;
+};
+
+/* Replace a run of sprite entries.
+ *
+ * chip:  Which VDC. (0 ~ 1)
+ * first: First sprite to replace. (0 ~ 63)
+ * count: How many entries to copy; stops at sprite 63.
+ * src:   The new entries.
+ */
+void vdc_spr_update_array(int chip, int first, int count,
+                          const struct vdc_sprite *src);
+
+/* Move a run of sprites on the VDC chosen with vdc_set().
+ *
+ * first:  First sprite to move. (0 ~ 63)
+ * count:  How many sprites; stops at sprite 63.
+ * xy:     X at xy[0] and Y at xy[1] for the first sprite.
+ * stride: Distance in bytes from one sprite's X to the next one's
+ *         (4 for a plain array of x/y pairs).
+ */
+void vdc_spr_xy_array(int first, int count, const u16 *xy, int stride);
+
 
 
 //***************************************
@@ -189,6 +267,43 @@ u16 vdc_status(int chip);
  */
 void vdc_setreg(int chip, int reg, int value);
 
+/* Get the value last written to a VDC register.
+ *
+ * Comes from the library's copy in RAM, as the registers are write-only.
+ * MAWR/MARR give the last address set with vdc_setreg() or
+ * vdc_set_vram_write()/vdc_set_vram_read(); other functions move them.
+ * chip: Which VDC. (0 ~ 1)
+ * reg:  Which VDC register. (0 ~ 0x13)
+ */
+u16 vdc_getreg(int chip, int reg);
+
+/* Set or clear bits in the VDC Control register (CR).
+ *
+ * The other bits keep their last written value. IRQs are held off
+ * while CR is being changed.
+ * chip: Which VDC. (0 ~ 1)
+ * bits: The bits to change (VDC_CR_* values).
+ */
+void vdc_cr_set_bits(int chip, u16 bits);
+void vdc_cr_clear_bits(int chip, u16 bits);
+
+/* Get the register number currently selected on a VDC.
+ *
+ * An IRQ handler which touches VDC registers should fetch this first and
+ * give it to vdc_set_regnum() before returning.
+ * Note: 0x13 (DVSSR) comes back as 0x03, and 0x10 ~ 0x12 are not kept,
+ * so DMA should not be started while IRQs are possible.
+ * chip: Which VDC. (0 ~ 1)
+ */
+int vdc_get_last_regnum(int chip);
+
+/* Select a VDC register without writing to it.
+ *
+ * chip: Which VDC. (0 ~ 1)
+ * reg:  Register number, usually from vdc_get_last_regnum().
+ */
+void vdc_set_regnum(int chip, int reg);
+
 
 /* Set the VRAM write address for a VDC chip.
  *
@@ -204,6 +319,46 @@ void vdc_set_vram_write(int chip, u16 addr);
  */
 void vdc_vram_write(int chip, u16 data);
 
+/* Write a block of words to VRAM.
+ *
+ * Sets the write address once and streams the data. The VRAM
+ * auto-increment is 1 during the transfer, whatever CR says.
+ * chip:   Which VDC. (0 ~ 1)
+ * vaddr:  VRAM address to start at.
+ * src:    Data to write.
+ * nwords: How many 16-bit words to write.
+ */
+void vdc_vram_write_block(int chip, u16 vaddr, const u16 *src, int nwords);
+
+/* Write a block of words to VRAM, using the CR auto-increment.
+ *
+ * Same as vdc_vram_write_block(), but the address steps by the amount set
+ * in CR (VDC_CR_IW_xx), e.g. to fill a BAT column.
+ * chip:   Which VDC. (0 ~ 1)
+ * vaddr:  VRAM address to start at.
+ * src:    Data to write.
+ * nwords: How many 16-bit words to write.
+ */
+void vdc_vram_write_stream(int chip, u16 vaddr, const u16 *src, int nwords);
+
+/* Fill VRAM with one value.
+ *
+ * chip:   Which VDC. (0 ~ 1)
+ * vaddr:  VRAM address to start at.
+ * value:  Value to write.
+ * nwords: How many 16-bit words to write.
+ */
+void vdc_vram_fill(int chip, u16 vaddr, u16 value, int nwords);
+
+/* Read a block of words from VRAM.
+ *
+ * chip:   Which VDC. (0 ~ 1)
+ * vaddr:  VRAM address to start at.
+ * dst:    Where to put the data.
+ * nwords: How many 16-bit words to read.
+ */
+void vdc_vram_read_block(int chip, u16 vaddr, u16 *dst, int nwords);
+
 /* Set the VRAM read address for a VDC chip.
  *
  * chip:  Which VDC to set the read address for. (0 ~ 1)
@@ -263,5 +418,129 @@ void vdc_do_dma(int chip, u16 src, u16 dst, u16 len);
  */
 void vdc_set_satb_address(int chip, u16 addr);
 
+// VRAM-VRAM DMA queue
+//
+// Requests are queued per VDC and run one after the other: each one is
+// started from the VDC interrupt that signals the end of the previous one
+// (VDC_STAT_DV), so the CPU does not have to wait for them.
+//
+// How to use:
+// a) call vdc_dma_irq() from your VDC interrupt handler, with the status
+//    you read from vdc_status() (reading the status clears it)
+// b) queue requests with vdc_dma_queue(); the first one starts at once
+// c) each request's done() callback is called from the interrupt handler
+//    when its transfer is over
+//
+// While the queue is busy, use it for all VRAM-VRAM DMA on that VDC rather
+// than vdc_do_dma().
+//
+struct vdc_dma_req {
+	u16 src;     // Source address
+	u16 dst;     // Destination address
+	u16 len;     // Value for LENR, as with vdc_do_dma()
+	u16 flags;   // VDC_DCR_SRC_DEC and/or VDC_DCR_DST_DEC, or 0
+	void (*done)(int chip, struct vdc_dma_req *req);   // May be NULL
+	void *user;  // For the caller's use
+};
+
+/* Add a VRAM-VRAM DMA to a VDC's queue.
+ *
+ * The request is not copied; it must stay valid until done() is called.
+ * chip: Which VDC. (0 ~ 1)
+ * req:  The transfer.
+ * Returns 1 if the request was queued, 0 if the queue (8 entries) is full.
+ */
+int vdc_dma_queue(int chip, struct vdc_dma_req *req);
+
+/* Service the DMA queue from the VDC interrupt handler.
+ *
+ * Starts the next transfer, calls the finished request's done(), and
+ * reselects the VDC register that was selected when the IRQ came in.
+ * Does nothing unless status has VDC_STAT_DV set.
+ * chip:   Which VDC raised the interrupt. (0 ~ 1)
+ * status: Value returned by vdc_status().
+ */
+void vdc_dma_irq(int chip, u16 status);
+
+/* Number of queued transfers which are not finished (0 = idle).
+ *
+ * chip: Which VDC. (0 ~ 1)
+ */
+int vdc_dma_pending(int chip);
+
+/* Wait until a VDC's DMA queue is empty. IRQs must be enabled.
+ *
+ * chip: Which VDC. (0 ~ 1)
+ */
+void vdc_dma_wait(int chip);
+
+// Raster effect tables
+//
+// A table lists VDC register writes to do at given scanlines (for example
+// BXR/BYR for split screens and parallax). Each VDC has two tables: one in
+// use, and one being built; the finished one replaces the one in use at the
+// next VBlank, so a new table can be prepared any time during the frame.
+//
+// How to use:
+// a) enable the VBlank and raster IRQs (VDC_CR_IRQ_VC | VDC_CR_IRQ_RC), and
+//    call vdc_raster_irq() from your VDC interrupt handler with the status
+//    you read from vdc_status()
+// b) each time the effect changes: vdc_raster_begin(), vdc_raster_add() for
+//    each write, then vdc_raster_end() (an empty table turns effects off)
+//
+// Writes made by the tables are not seen by vdc_getreg(). A BYR write
+// takes effect on the following line, which shows background row BYR + 1
+// (see example 022).
+//
+
+/* Start building a new raster table.
+ *
+ * chip: Which VDC. (0 ~ 1)
+ */
+void vdc_raster_begin(int chip);
+
+/* Add a register write to the table being built.
+ *
+ * Up to 4 writes can share a line; up to 32 different lines per table.
+ * chip:  Which VDC. (0 ~ 1)
+ * line:  Scanline, counted from the top of the display; 0 means at VBlank,
+ *        for the whole next frame. Lines must be added in increasing order.
+ * reg:   Which VDC register. (0 ~ 0x13)
+ * value: The value to write.
+ * Returns 1 if added, 0 if there is no room or the line is out of order.
+ */
+int vdc_raster_add(int chip, int line, int reg, u16 value);
+
+/* Finish the table; it is used from the next VBlank on.
+ *
+ * chip: Which VDC. (0 ~ 1)
+ */
+void vdc_raster_end(int chip);
+
+/* Service the raster tables from the VDC interrupt handler.
+ *
+ * Handles VDC_STAT_RR and VDC_STAT_VD, and reselects the VDC register
+ * that was selected when the IRQ came in.
+ * chip:   Which VDC raised the interrupt. (0 ~ 1)
+ * status: Value returned by vdc_status().
+ */
+void vdc_raster_irq(int chip, u16 status);
+
+// Both chips at once
+//
+// These do the same as the functions without 'm', on every VDC in a chip
+// mask (VDC_MASK_0, VDC_MASK_1 or VDC_MASK_BOTH), in a single call. With
+// both chips, vdcm_init_xMHz() clears both VRAMs at the same time,
+// vdcm_setreg() and vdcm_set_scroll() select the register on both chips
+// and then write both data ports, and vdcm_vram_write_block() reads each
+// word once and writes it to both.
+//
+void vdcm_init_5MHz(int mask);
+void vdcm_init_7MHz(int mask);
+void vdcm_setreg(int mask, int reg, int value);
+void vdcm_set_scroll(int mask, u16 x, u16 y);
+void vdcm_vram_write_block(int mask, u16 vaddr, const u16 *src, int nwords);
+void vdcm_spr_commit(int mask);
+
 
 #endif
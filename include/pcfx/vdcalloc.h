@@ -0,0 +1,92 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+/*
+ * VDC VRAM allocator.
+ */
+
+#ifndef _LIBPCFX_VDCALLOC_H_
+#define _LIBPCFX_VDCALLOC_H_
+
+#include <pcfx/types.h>
+
+// Each VDC's 64K words of VRAM are handed out in units of 16 words (one
+// 8x8 tile). Sprite patterns must start on a 64-word boundary, so ask for
+// VDC_VALLOC_SPRITE alignment for them.
+//
+// How to use:
+// a) vdc_valloc_init() after vdc_init_5MHz()/vdc_init_7MHz(); this keeps
+//    the BAT and the SATB (at 0xFF00, as set by vdc_init) out of the pool
+// b) vdc_valloc() / vdc_vfree() for areas you fill yourself, or
+// c) vdc_pattern_load() / vdc_pattern_release() for graphics: the same data
+//    loaded twice is only uploaded once, and stays until every user has
+//    released it
+//
+
+#define VDC_VALLOC_TILE        16     // Alignment (words) for BG tiles
+#define VDC_VALLOC_SPRITE      64     // Alignment (words) for sprite patterns
+
+#define VDC_VALLOC_PATTERNS    64     // Patterns tracked per VDC by vdc_pattern_load()
+
+struct vdc_valloc_stats {
+	int free_words;
+	int used_words;
+	int largest_free;    // Biggest single free area, in words
+	int free_areas;      // Number of separate free areas
+	int patterns;        // Patterns loaded by vdc_pattern_load()
+};
+
+/* Start the allocator for a VDC, with all VRAM free except the BAT and SATB.
+ *
+ * chip:      Which VDC. (0 ~ 1)
+ * bat_words: Size of the BAT at address 0 (e.g. 32*32 = 1024).
+ */
+void vdc_valloc_init(int chip, int bat_words);
+
+/* Mark an area as used, for things placed by hand.
+ *
+ * vaddr: VRAM address; rounded down to a 16-word unit.
+ * words: Size; rounded up to a 16-word unit.
+ */
+void vdc_valloc_reserve(int chip, u16 vaddr, int words);
+
+/* Allocate VRAM.
+ *
+ * words: Size, in words.
+ * align: VDC_VALLOC_TILE, VDC_VALLOC_SPRITE, or a larger power of two.
+ * Returns the VRAM address, or -1 if there is no free area big enough.
+ */
+int vdc_valloc(int chip, int words, int align);
+
+/* Free VRAM from vdc_valloc() or vdc_valloc_reserve().
+ */
+void vdc_vfree(int chip, u16 vaddr, int words);
+
+/* Load graphics into VRAM, or reuse them if they are already there.
+ *
+ * data:  Pattern data. Must stay in memory while loaded; it is compared
+ *        against later loads.
+ * words: Size, in words.
+ * align: As for vdc_valloc().
+ * Returns the VRAM address, or -1 if VRAM or the pattern table is full.
+ */
+int vdc_pattern_load(int chip, const u16 *data, int words, int align);
+
+/* Drop one use of a pattern from vdc_pattern_load(); its VRAM is freed
+ * when the last user releases it.
+ *
+ * vaddr: The address vdc_pattern_load() returned.
+ */
+void vdc_pattern_release(int chip, u16 vaddr);
+
+/* Get the free/used totals and how broken up the free space is.
+ */
+void vdc_valloc_stats(int chip, struct vdc_valloc_stats *stats);
+
+#endif
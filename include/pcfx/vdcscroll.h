@@ -0,0 +1,90 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+/*
+ * Scrolling over maps larger than the VDC BAT.
+ */
+
+#ifndef _LIBPCFX_VDCSCROLL_H_
+#define _LIBPCFX_VDCSCROLL_H_
+
+#include <pcfx/types.h>
+#include <pcfx/vdc.h>
+
+// The BAT (at VRAM address 0) is used as a ring: map tile (col, row) is
+// kept at BAT position (col % BAT width, row % BAT height), and the VDC
+// wraps around the BAT by itself when scrolling. When the view moves onto
+// a new tile column or row, only that column or row is written to the BAT;
+// columns are written with the VRAM auto-increment set to the BAT width.
+//
+// How to use:
+// a) set MWR for the BAT size (e.g. VDC_MWR_SCREEN_64x32)
+// b) vdc_scroller_init(), then give a map with vdc_scroller_set_map() or
+//    a fetch function with vdc_scroller_set_fetch()
+// c) vdc_scroller_redraw() once, then vdc_scroller_move() each frame
+//    (in VBlank, or before the frame starts being displayed)
+//
+// The BAT must be at least one tile wider and taller than the view.
+//
+
+/* Fetch n BAT words of the map, starting at map tile (col, row), going
+ * down the column if vertical is 1, along the row if it is 0.
+ * Tiles outside the map can be given any value.
+ */
+typedef void (*vdc_scroller_fetch)(void *user, int col, int row, int n,
+                                   int vertical, u16 *out);
+
+struct vdc_scroller {
+	int chip;
+	int bat_w, bat_h;          // BAT size in tiles
+	int cols, rows;            // Tiles kept up to date (view + 1)
+	int col0, row0;            // Map tile at the top-left of that area
+	int x, y;                  // Scroll position, in pixels
+
+	const u16 *map;            // RAM map of BAT words, row by row
+	int map_w, map_h;          // Its size in tiles
+	vdc_scroller_fetch fetch;  // Used instead when map is NULL
+	void *user;
+};
+
+/* Set up a scroller.
+ *
+ * s:      The scroller.
+ * chip:   Which VDC. (0 ~ 1)
+ * mwr:    The VDC_MWR_SCREEN_xx size given to MWR.
+ * view_w: Width of the display, in pixels.
+ * view_h: Height of the display, in pixels.
+ * Returns 1, or 0 if the BAT is too small for the view.
+ */
+int vdc_scroller_init(struct vdc_scroller *s, int chip, int mwr,
+                      int view_w, int view_h);
+
+/* Use a map in RAM. Tiles outside it are written as 0.
+ *
+ * map:   BAT words (palette << 12 | pattern address >> 4), row by row.
+ * w, h:  Size of the map in tiles.
+ */
+void vdc_scroller_set_map(struct vdc_scroller *s, const u16 *map, int w, int h);
+
+/* Use a function to get tiles (e.g. to decompress them).
+ */
+void vdc_scroller_set_fetch(struct vdc_scroller *s, vdc_scroller_fetch fetch,
+                            void *user);
+
+/* Write the whole visible area for scroll position (x, y), and scroll there.
+ */
+void vdc_scroller_redraw(struct vdc_scroller *s, int x, int y);
+
+/* Scroll to (x, y), writing only the tiles which come into view.
+ *
+ * Jumps further than the view size are done with vdc_scroller_redraw().
+ */
+void vdc_scroller_move(struct vdc_scroller *s, int x, int y);
+
+#endif
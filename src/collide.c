@@ -0,0 +1,278 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include <pcfx/types.h>
+#include <pcfx/vdc.h>
+#include <pcfx/collide.h>
+
+#define BUCKETS       256
+#define MAX_SPAN      16      // objects covering more cells are tested against all
+
+struct object {
+	int x0, y0, x1, y1;      // x1, y1 are one past the edge
+	u16 group, mask;
+};
+
+struct entry {
+	s16 cx, cy;
+	u8 obj;
+	u8 bucket;
+};
+
+static struct object objs[COLL_MAX_OBJECTS];
+static struct entry entries[COLL_MAX_CELLS];
+static struct entry sorted[COLL_MAX_CELLS];
+static u16 bucket_start[BUCKETS + 1];
+static u8 big[COLL_MAX_OBJECTS];
+static u8 is_big[COLL_MAX_OBJECTS];
+static u16 stamp[COLL_MAX_OBJECTS];
+static u16 query_stamp;
+static int nobjs, nentries, nbig;
+static int cell_shift = 5;
+static int built;
+
+static int hash_cell(int cx, int cy)
+{
+	return (((u32)cx * 73856093u) ^ ((u32)cy * 19349663u)) >> 24;
+}
+
+static int overlap(const struct object *a, const struct object *b)
+{
+	return (a->x0 < b->x1) && (b->x0 < a->x1) &&
+	       (a->y0 < b->y1) && (b->y0 < a->y1);
+}
+
+static int can_hit(const struct object *a, const struct object *b)
+{
+	return ((a->group & b->mask) | (b->group & a->mask)) != 0;
+}
+
+// Sort the entries by bucket (counting sort)
+static void build(void)
+{
+	int i, sum, n;
+
+	for(i = 0; i <= BUCKETS; i++)
+		bucket_start[i] = 0;
+	for(i = 0; i < nentries; i++)
+		bucket_start[entries[i].bucket]++;
+
+	sum = 0;
+	for(i = 0; i < BUCKETS; i++) {
+		n = bucket_start[i];
+		bucket_start[i] = sum;
+		sum += n;
+	}
+	bucket_start[BUCKETS] = sum;
+
+	for(i = 0; i < nentries; i++)
+		sorted[bucket_start[entries[i].bucket]++] = entries[i];
+
+	// the fill moved each start to the next bucket's start; shift back
+	for(i = BUCKETS; i > 0; i--)
+		bucket_start[i] = bucket_start[i - 1];
+	bucket_start[0] = 0;
+
+	built = 1;
+}
+
+void coll_begin(int shift)
+{
+	cell_shift = shift;
+	nobjs = nentries = nbig = 0;
+	built = 0;
+}
+
+int coll_add(int x, int y, int w, int h, u16 group, u16 mask)
+{
+	struct object *o;
+	struct entry *e;
+	int cx0, cy0, cx1, cy1, cx, cy;
+
+	if((nobjs == COLL_MAX_OBJECTS) || (w <= 0) || (h <= 0))
+		return -1;
+
+	o = &objs[nobjs];
+	o->x0 = x;
+	o->y0 = y;
+	o->x1 = x + w;
+	o->y1 = y + h;
+	o->group = group;
+	o->mask = mask;
+	is_big[nobjs] = 0;
+	stamp[nobjs] = query_stamp;
+	built = 0;
+
+	cx0 = x >> cell_shift;
+	cy0 = y >> cell_shift;
+	cx1 = (o->x1 - 1) >> cell_shift;
+	cy1 = (o->y1 - 1) >> cell_shift;
+
+	if(((cx1 - cx0 + 1) * (cy1 - cy0 + 1) > MAX_SPAN) ||
+	   (nentries + (cx1 - cx0 + 1) * (cy1 - cy0 + 1) > COLL_MAX_CELLS)) {
+		is_big[nobjs] = 1;
+		big[nbig++] = nobjs;
+		return nobjs++;
+	}
+
+	for(cy = cy0; cy <= cy1; cy++) {
+		for(cx = cx0; cx <= cx1; cx++) {
+			e = &entries[nentries++];
+			e->cx = cx;
+			e->cy = cy;
+			e->obj = nobjs;
+			e->bucket = hash_cell(cx, cy);
+		}
+	}
+	return nobjs++;
+}
+
+int coll_add_sprite(int chip, int spr, u16 group, u16 mask)
+{
+	u16 ctrl;
+	int w, h;
+
+	vdc_set(chip);
+	vdc_spr_set(spr);
+	ctrl = vdc_spr_get_ctrl();
+
+	w = (ctrl & VDC_SPR_X_WIDTH_2) ? 32 : 16;
+	switch(ctrl & VDC_SPR_Y_HEIGHT_4) {
+	case VDC_SPR_Y_HEIGHT_1:
+		h = 16;
+		break;
+	case VDC_SPR_Y_HEIGHT_2:
+		h = 32;
+		break;
+	default:
+		h = 64;
+		break;
+	}
+
+	return coll_add((int)(vdc_spr_get_x() & 0x3FF) - 32,
+	                (int)(vdc_spr_get_y() & 0x3FF) - 64, w, h, group, mask);
+}
+
+int coll_pairs(struct coll_hit *hits, int max)
+{
+	const struct entry *ei, *ej, *end;
+	const struct object *a, *b;
+	int n = 0;
+	int bk, i, j, ox, oy;
+
+	if(!built)
+		build();
+
+	for(bk = 0; bk < BUCKETS; bk++) {
+		end = &sorted[bucket_start[bk + 1]];
+		for(ei = &sorted[bucket_start[bk]]; ei < end; ei++) {
+			a = &objs[ei->obj];
+			for(ej = ei + 1; ej < end; ej++) {
+				if((ej->cx != ei->cx) || (ej->cy != ei->cy))
+					continue;
+				b = &objs[ej->obj];
+				if(!can_hit(a, b) || !overlap(a, b))
+					continue;
+
+				// only give the pair in the cell holding the
+				// top-left corner of the overlap
+				ox = (a->x0 > b->x0) ? a->x0 : b->x0;
+				oy = (a->y0 > b->y0) ? a->y0 : b->y0;
+				if(((ox >> cell_shift) != ei->cx) || ((oy >> cell_shift) != ei->cy))
+					continue;
+
+				if(n == max)
+					return n;
+				if(ei->obj < ej->obj) {
+					hits[n].a = ei->obj;
+					hits[n].b = ej->obj;
+				}
+				else {
+					hits[n].a = ej->obj;
+					hits[n].b = ei->obj;
+				}
+				n++;
+			}
+		}
+	}
+
+	// objects too big for the grid are tested against everything
+	for(i = 0; i < nbig; i++) {
+		a = &objs[big[i]];
+		for(j = 0; j < nobjs; j++) {
+			if((j == big[i]) || (is_big[j] && (j < big[i])))
+				continue;
+			b = &objs[j];
+			if(!can_hit(a, b) || !overlap(a, b))
+				continue;
+			if(n == max)
+				return n;
+			hits[n].a = (j < big[i]) ? j : big[i];
+			hits[n].b = (j < big[i]) ? big[i] : j;
+			n++;
+		}
+	}
+	return n;
+}
+
+int coll_query(int x, int y, int w, int h, u16 mask, u8 *ids, int max)
+{
+	struct object box;
+	const struct entry *e, *end;
+	int cx0, cy0, cx1, cy1, cx, cy, bk, i;
+	int n = 0;
+
+	if((w <= 0) || (h <= 0))
+		return 0;
+	if(!built)
+		build();
+
+	box.x0 = x;
+	box.y0 = y;
+	box.x1 = x + w;
+	box.y1 = y + h;
+
+	// stamp marks objects already given by this query
+	if(++query_stamp == 0) {
+		for(i = 0; i < nobjs; i++)
+			stamp[i] = 0;
+		query_stamp = 1;
+	}
+
+	cx0 = x >> cell_shift;
+	cy0 = y >> cell_shift;
+	cx1 = (box.x1 - 1) >> cell_shift;
+	cy1 = (box.y1 - 1) >> cell_shift;
+
+	for(cy = cy0; cy <= cy1; cy++) {
+		for(cx = cx0; cx <= cx1; cx++) {
+			bk = hash_cell(cx, cy);
+			end = &sorted[bucket_start[bk + 1]];
+			for(e = &sorted[bucket_start[bk]]; e < end; e++) {
+				if((e->cx != cx) || (e->cy != cy) || (stamp[e->obj] == query_stamp))
+					continue;
+				stamp[e->obj] = query_stamp;
+				if(!(objs[e->obj].group & mask) || !overlap(&box, &objs[e->obj]))
+					continue;
+				if(n == max)
+					return n;
+				ids[n++] = e->obj;
+			}
+		}
+	}
+
+	for(i = 0; i < nbig; i++) {
+		if(!(objs[big[i]].group & mask) || !overlap(&box, &objs[big[i]]))
+			continue;
+		if(n == max)
+			return n;
+		ids[n++] = big[i];
+	}
+	return n;
+}
@@ -0,0 +1,258 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include <pcfx/types.h>
+#include <pcfx/king.h>
+#include <pcfx/fmv.h>
+#include <eris/cd.h>
+#include <eris/scsi.h>
+
+enum {
+	ST_IDLE,          // no read running
+	ST_WAIT_DATA,     // READ(10) sent, waiting for the data phase
+	ST_DMA,           // SCSI DMA into KRAM running
+	ST_WAIT_STATUS,   // DMA done, waiting for the status phase
+	ST_WAIT_FREE,     // status read, waiting for the bus to be free
+	ST_FAILED,        // a read failed FMV_RETRIES times
+};
+
+#define FMV_RETRIES      3
+#define FMV_TIMEOUT      180    // VBlanks to wait on the drive (3 seconds)
+
+static void send_read10(u32 lba, u32 sectors)
+{
+	u8 cdb[10];
+
+	cdb[0] = SCSI_CMD_READ10;
+	cdb[1] = 0;
+	cdb[2] = lba >> 24;
+	cdb[3] = lba >> 16;
+	cdb[4] = lba >> 8;
+	cdb[5] = lba;
+	cdb[6] = 0;
+	cdb[7] = sectors >> 8;
+	cdb[8] = sectors;
+	cdb[9] = 0;
+	eris_scsi_command(cdb, 10);
+}
+
+static int part_sectors(const struct fmv *f)
+{
+	return f->sizes[(f->read_frame << 1) + f->read_part];
+}
+
+static u32 part_kram(const struct fmv *f)
+{
+	u32 slot = f->read_frame % f->slots;
+
+	if(f->read_part == 0)
+		return f->video_kram + slot * f->video_slot_words;
+	return f->audio_kram + slot * f->audio_slot_words;
+}
+
+static void wait_for(struct fmv *f, int state)
+{
+	f->state = state;
+	f->waited = 0;
+}
+
+// A read ended without data or with a bad status: send it again once the
+// bus is free, or give up after FMV_RETRIES tries.
+static int read_failed(struct fmv *f)
+{
+	if(++f->retries < FMV_RETRIES) {
+		wait_for(f, ST_WAIT_FREE);
+		return 1;
+	}
+	f->state = ST_FAILED;
+	f->failed = 1;
+	f->playing = 0;
+	return 0;
+}
+
+// The drive sat in one phase for FMV_TIMEOUT VBlanks, e.g. after it
+// rejected or aborted a read: reset it and count a failed try.
+static int timed_out(struct fmv *f)
+{
+	eris_scsi_reset();
+	return read_failed(f);
+}
+
+static void next_part(struct fmv *f)
+{
+	if(++f->read_part == 2) {
+		f->read_part = 0;
+		f->read_frame++;
+	}
+}
+
+int fmv_open(struct fmv *f, u32 lba, u8 *table, u32 table_size,
+             u32 video_kram, u32 audio_kram, int slots)
+{
+	struct fmv_header *hdr = &f->hdr;
+	u8 *dst = (u8 *)hdr;
+	u32 i;
+
+	if((slots < 3) || (table_size < FMV_SECTOR))
+		return 0;
+	eris_cd_read(lba, table, FMV_SECTOR);
+	for(i = 0; i < sizeof(struct fmv_header); i++)    // table may be unaligned
+		dst[i] = table[i];
+	if((hdr->magic != FMV_MAGIC) || (hdr->version != 1) ||
+	   (hdr->header_sectors == 0) || (hdr->vblanks_per_frame == 0) ||
+	   ((u32)hdr->header_sectors * FMV_SECTOR > table_size) ||
+	   (sizeof(struct fmv_header) + hdr->frames * 2 > (u32)hdr->header_sectors * FMV_SECTOR))
+		return 0;
+	if(hdr->header_sectors > 1)
+		eris_cd_read(lba + 1, table + FMV_SECTOR, (hdr->header_sectors - 1) * FMV_SECTOR);
+
+	f->sizes = table + sizeof(struct fmv_header);
+	f->lba = lba + hdr->header_sectors;
+	f->video_kram = video_kram;
+	f->audio_kram = audio_kram;
+	f->slots = slots;
+	f->video_slot_words = (u32)hdr->max_video_sectors * (FMV_SECTOR / 2);
+	f->audio_slot_words = (u32)hdr->max_audio_sectors * (FMV_SECTOR / 2);
+
+	f->read_frame = 0;
+	f->shown_frame = 0;
+	f->read_part = 0;
+	f->state = ST_IDLE;
+	f->retries = 0;
+	f->failed = 0;
+	f->waited = 0;
+	f->playing = 0;
+	f->ticks = 0;
+	f->dropped = 0;
+	f->audio = 0;
+	return 1;
+}
+
+void fmv_set_audio(struct fmv *f, fmv_audio_fn audio)
+{
+	f->audio = audio;
+}
+
+int fmv_start(struct fmv *f)
+{
+	// keep one slot for the frame on screen
+	while((f->read_frame < f->hdr.frames) && (f->read_frame + 1 < (u32)f->slots))
+		if(!fmv_service(f))
+			return 0;
+
+	f->ticks = 0;
+	f->playing = 1;
+	return 1;
+}
+
+int fmv_service(struct fmv *f)
+{
+	int n;
+	scsi_status st;
+
+	switch(f->state) {
+	case ST_IDLE:
+		if(f->read_frame >= f->hdr.frames)
+			return f->shown_frame < f->hdr.frames;
+		// the frame on screen (shown_frame - 1) is still in use
+		if(f->read_frame + 1 - f->shown_frame >= (u32)f->slots)
+			return 1;
+
+		n = part_sectors(f);
+		if(n == 0) {                    // e.g. a frame without audio
+			next_part(f);
+			return 1;
+		}
+		send_read10(f->lba, n);
+		wait_for(f, ST_WAIT_DATA);
+		return 1;
+
+	case ST_WAIT_DATA:
+		switch(eris_scsi_get_phase()) {
+		case SCSI_PHASE_DATA_IN:
+			break;
+		case SCSI_PHASE_STATUS:         // no data, e.g. CHECK CONDITION
+			eris_scsi_status();
+			return read_failed(f);
+		default:                        // e.g. MESSAGE IN or BUS FREE
+			if(f->waited < FMV_TIMEOUT)
+				return 1;
+			return timed_out(f);
+		}
+		eris_scsi_begin_dma(part_kram(f), part_sectors(f) * FMV_SECTOR);
+		wait_for(f, ST_DMA);
+		return 1;
+
+	case ST_DMA:
+		if(eris_scsi_check_dma()) {
+			if(f->waited < FMV_TIMEOUT)
+				return 1;
+			eris_scsi_finish_dma();
+			return timed_out(f);
+		}
+		eris_scsi_finish_dma();
+		wait_for(f, ST_WAIT_STATUS);
+		return 1;
+
+	case ST_WAIT_STATUS:
+		if(eris_scsi_get_phase() != SCSI_PHASE_STATUS) {
+			if(f->waited < FMV_TIMEOUT)
+				return 1;
+			return timed_out(f);
+		}
+		st = eris_scsi_status();
+		if(st != SCSI_STATUS_GOOD)      // the data may be bad: read it again
+			return read_failed(f);
+		f->retries = 0;
+		f->lba += part_sectors(f);
+		next_part(f);
+		wait_for(f, ST_WAIT_FREE);
+		return 1;
+
+	case ST_WAIT_FREE:
+		// the message phase must be over before the next READ(10)
+		if(eris_scsi_get_phase() != SCSI_PHASE_BUS_FREE) {
+			if(f->waited < FMV_TIMEOUT)
+				return 1;
+			return timed_out(f);
+		}
+		f->state = ST_IDLE;
+		return 1;
+
+	case ST_FAILED:
+		return 0;
+	}
+	return 1;
+}
+
+void fmv_vblank(struct fmv *f)
+{
+	u32 due, slot;
+
+	f->waited++;
+	if(!f->playing)
+		return;
+
+	due = f->ticks++ / f->hdr.vblanks_per_frame;
+	if((due < f->shown_frame) || (due >= f->hdr.frames))
+		return;
+	if(due >= f->read_frame)        // not read yet: keep the last picture
+		return;
+
+	f->dropped += due - f->shown_frame;
+	slot = due % f->slots;
+
+	king_rainbow_transfer(f->video_kram + slot * f->video_slot_words, 0,
+	                      (f->hdr.height + 15) >> 4, 0);
+	if(f->audio && f->sizes[(due << 1) + 1])
+		f->audio(f->audio_kram + slot * f->audio_slot_words,
+		         f->sizes[(due << 1) + 1] * FMV_SECTOR, due);
+
+	f->shown_frame = due + 1;
+}
@@ -0,0 +1,51 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include <pcfx/types.h>
+#include <pcfx/fixed.h>
+#include <pcfx/king.h>
+#include <pcfx/kingline.h>
+#include <pcfx/kingaffine.h>
+
+void king_affine_show(const struct king_affine *lines, int first, int count)
+{
+	king_line_show(KING_LINE_AFFINE, lines, first, count);
+}
+
+int king_affine_pending(void)
+{
+	return king_line_pending(KING_LINE_AFFINE);
+}
+
+static s16 to_8_8(fix16 v)
+{
+	v >>= 8;
+	if(v > 0x7FFF)
+		return 0x7FFF;
+	if(v < -0x8000)
+		return -0x8000;
+	return v;
+}
+
+void king_affine_rotscale(struct king_affine *m, int angle, fix16 scale_x,
+                          fix16 scale_y, int cx, int cy)
+{
+	fix16 s = fix16_sin(angle);
+	fix16 c = fix16_cos(angle);
+	fix16 inv_x = fix16_div(FIX16_ONE, scale_x);
+	fix16 inv_y = fix16_div(FIX16_ONE, scale_y);
+
+	// screen -> BG is the inverse: divide by the zoom, rotate by -angle
+	m->a = to_8_8(fix16_mul(c, inv_x));
+	m->b = to_8_8(fix16_mul(s, inv_y));
+	m->c = to_8_8(fix16_mul(-s, inv_x));
+	m->d = to_8_8(fix16_mul(c, inv_y));
+	m->cx = cx;
+	m->cy = cy;
+}
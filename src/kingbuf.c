@@ -0,0 +1,109 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include <pcfx/types.h>
+#include <pcfx/king.h>
+#include <pcfx/kramalloc.h>
+#include <pcfx/kingbuf.h>
+
+#define BGS   5         // KING_BG0 ~ KING_BG3, with KING_BG0SUB
+
+static struct king_bgbuf *volatile bufs[BGS];
+
+static void show(const struct king_bgbuf *b, int n)
+{
+	king_set_bat_cg_addr(b->bg, KING_KRAM_BLOCK(b->bat[n]),
+	                     KING_KRAM_BLOCK(b->cg[n]));
+}
+
+void king_bgbuf_init(struct king_bgbuf *b, king_bg bg, u32 bat0, u32 cg0,
+                     u32 bat1, u32 cg1)
+{
+	b->bg = bg;
+	b->bat[0] = bat0;
+	b->cg[0] = cg0;
+	b->bat[1] = bat1;
+	b->cg[1] = cg1;
+	b->front = 0;
+	b->flip = 0;
+	show(b, 0);
+	bufs[bg] = b;
+}
+
+int king_bgbuf_alloc(struct king_bgbuf *b, king_bg bg, int bat_words,
+                     int cg_words)
+{
+	u32 bat[2] = { 0, 0 }, cg[2];
+	int i;
+
+	for(i = 0; i < 2; i++) {
+		cg[i] = king_kalloc(KING_KRAM_BG, cg_words, 0);
+		if(cg[i] == KING_KALLOC_NONE)
+			goto fail;
+		if(bat_words > 0) {
+			bat[i] = king_kalloc(KING_KRAM_BG, bat_words, 0);
+			if(bat[i] == KING_KALLOC_NONE) {
+				king_kfree(KING_KRAM_BG, cg[i], cg_words);
+				goto fail;
+			}
+		}
+	}
+	king_bgbuf_init(b, bg, bat[0], cg[0], bat[1], cg[1]);
+	return 1;
+
+fail:
+	if(i == 1) {
+		king_kfree(KING_KRAM_BG, cg[0], cg_words);
+		if(bat_words > 0)
+			king_kfree(KING_KRAM_BG, bat[0], bat_words);
+	}
+	return 0;
+}
+
+void king_bgbuf_remove(struct king_bgbuf *b)
+{
+	if(bufs[b->bg] == b)
+		bufs[b->bg] = 0;
+}
+
+void king_bgbuf_flip(struct king_bgbuf *b)
+{
+	b->flip = 1;
+}
+
+int king_bgbuf_flipping(const struct king_bgbuf *b)
+{
+	return b->flip;
+}
+
+void king_bgbuf_wait(const struct king_bgbuf *b)
+{
+	while(b->flip)
+		;
+}
+
+void king_bgbuf_vblank(void)
+{
+	struct king_bgbuf *b;
+	int reg = -1;
+	int i;
+
+	for(i = 0; i < BGS; i++) {
+		b = bufs[i];
+		if(!b || !b->flip)
+			continue;
+		if(reg < 0)
+			reg = king_get_last_regnum();
+		b->front ^= 1;
+		show(b, b->front);
+		b->flip = 0;
+	}
+	if(reg >= 0)
+		king_set_regnum(reg);
+}
@@ -0,0 +1,135 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include <pcfx/types.h>
+#include <pcfx/vdc.h>
+#include <pcfx/king.h>
+#include <pcfx/kingline.h>
+
+#define KING_REG_SCROLL   0x30     // BGn X at 0x30 + 2n, Y at 0x31 + 2n
+
+struct channel {
+	const void *table;
+	int first, count;
+	int next;                      // next entry to write this frame
+
+	const void *volatile new_table;
+	volatile int new_first, new_count;
+	volatile int pending;          // non-zero: swap at next VBlank
+};
+
+static struct channel channels[KING_LINE_CHANNELS];
+static int rcr_line = -1;          // line RCR was set for, -1 if none
+
+static void apply(int ch, int n)
+{
+	const struct king_scroll_line *s;
+
+	if(ch == KING_LINE_AFFINE) {
+		king_load_bg0_affine((const struct king_affine *)channels[ch].table + n);
+		return;
+	}
+	s = (const struct king_scroll_line *)channels[ch].table + n;
+	king_write_reg(KING_REG_SCROLL + (ch << 1), s->x);
+	king_write_reg(KING_REG_SCROLL + (ch << 1) + 1, s->y);
+}
+
+void king_line_show(int channel, const void *lines, int first, int count)
+{
+	struct channel *c;
+
+	if((channel < 0) || (channel >= KING_LINE_CHANNELS))
+		return;
+	c = &channels[channel];
+	c->pending = 0;                // a table not shown yet is dropped
+	c->new_table = lines;
+	c->new_first = (first < 0) ? 0 : first;
+	c->new_count = (lines && (count > 0)) ? count : 0;
+	c->pending = 1;                // set last: the IRQ may swap from here on
+}
+
+int king_line_pending(int channel)
+{
+	if((channel < 0) || (channel >= KING_LINE_CHANNELS))
+		return 0;
+	return channels[channel].pending;
+}
+
+static int scroll_channel(king_bg bg)
+{
+	if(bg == KING_BG0)
+		return KING_LINE_SCROLL(0);
+	if(bg == KING_BG0SUB)
+		return -1;
+	return KING_LINE_SCROLL(bg - 1);
+}
+
+void king_scroll_show(king_bg bg, const struct king_scroll_line *lines,
+                      int first, int count)
+{
+	king_line_show(scroll_channel(bg), lines, first, count);
+}
+
+int king_scroll_pending(king_bg bg)
+{
+	return king_line_pending(scroll_channel(bg));
+}
+
+void king_line_irq(int chip, u16 status)
+{
+	struct channel *c;
+	int vdc_reg, king_reg, line, i;
+
+	if(!(status & (VDC_STAT_RR | VDC_STAT_VD)))
+		return;
+	vdc_reg = vdc_get_last_regnum(chip);
+	king_reg = king_get_last_regnum();
+
+	if((status & VDC_STAT_RR) && (rcr_line >= 0)) {
+		for(i = 0; i < KING_LINE_CHANNELS; i++) {
+			c = &channels[i];
+			if((c->next < c->count) && (c->first + c->next - 1 <= rcr_line)) {
+				// an IRQ came late: only the newest entry counts
+				while((c->next + 1 < c->count) && (c->first + c->next <= rcr_line))
+					c->next++;
+				apply(i, c->next++);
+			}
+		}
+	}
+
+	if(status & VDC_STAT_VD) {
+		for(i = 0; i < KING_LINE_CHANNELS; i++) {
+			c = &channels[i];
+			if(c->pending) {
+				c->table = c->new_table;
+				c->first = c->new_first;
+				c->count = c->new_count;
+				c->pending = 0;
+			}
+			c->next = 0;
+			if(c->count)
+				apply(i, c->next++);
+		}
+	}
+
+	// a write lands on the line after the one it is made in
+	rcr_line = -1;
+	for(i = 0; i < KING_LINE_CHANNELS; i++) {
+		c = &channels[i];
+		if(c->next >= c->count)
+			continue;
+		line = c->first + c->next - 1;
+		if((rcr_line < 0) || (line < rcr_line))
+			rcr_line = line;
+	}
+	vdc_setreg(chip, VDC_REG_RCR, (rcr_line < 0) ? 0 : rcr_line + 64);    // RCR counts from 64
+
+	king_set_regnum(king_reg);
+	vdc_set_regnum(chip, vdc_reg);
+}
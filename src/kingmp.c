@@ -0,0 +1,67 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include <pcfx/types.h>
+#include <pcfx/king.h>
+
+#define PROG_LEN   16
+
+// CG reads per 8 pixels, by color mode (bits 0-2 of the mode); 6 and 7
+// are the EXTDOT 64K/16M BAT modes
+static const u8 cg_reads[8] = { 0, 1, 2, 4, 8, 8, 8, 8 };
+
+int king_build_microprogram(u16 *prog, u16 modes, int rotate,
+			struct king_mp_report *report)
+{
+	int slot = 0, needed = 0, dropped = 0;
+	int bg, mode, bat, cg, i;
+	u16 rot;
+
+	for(i = 0; i < PROG_LEN; i++)
+		prog[i] = KING_CODE_NOP;
+
+	for(bg = 0; bg < 4; bg++) {
+		mode = (modes >> (bg << 2)) & 0xF;
+		cg = cg_reads[mode & 7];
+		if(cg == 0)
+			continue;
+		bat = (mode & KING_BGMODE_BAT) ? 1 : 0;
+		rot = ((bg == 0) && rotate) ? 1 : 0;
+
+		needed += bat + cg;
+		if(slot + bat + cg > KING_MP_SLOTS) {
+			dropped |= 1 << bg;
+			continue;
+		}
+
+		if(bat)
+			prog[slot++] = KING_CODE(0, 2, rot, bg, 0);
+		for(i = 0; i < cg; i++)
+			prog[slot++] = KING_CODE(i, bat, rot, bg, 0);
+	}
+
+	if(report) {
+		report->slots_used = slot;
+		report->slots_needed = needed;
+		report->dropped = dropped;
+	}
+	return dropped == 0;
+}
+
+int king_setup_microprogram(int rotate, struct king_mp_report *report)
+{
+	u16 prog[PROG_LEN];
+	int ok;
+
+	ok = king_build_microprogram(prog, king_get_bg_mode(), rotate, report);
+	king_disable_microprogram();
+	king_write_microprogram(prog, 0, PROG_LEN);
+	king_enable_microprogram();
+	return ok;
+}
@@ -0,0 +1,190 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include <pcfx/types.h>
+#include <pcfx/king.h>
+#include <pcfx/kingscroll.h>
+
+#define MAX_RUN  128    // longest row/column written at once (BAT is at most 128 wide)
+
+static u16 run_buf[MAX_RUN];
+
+static void fetch_ram(const struct king_scroller *s, int col, int row, int n,
+                      int vertical, u16 *out)
+{
+	const u16 *p;
+	int i;
+
+	if(vertical) {
+		if((col < 0) || (col >= s->map_w)) {
+			for(i = 0; i < n; i++)
+				out[i] = 0;
+			return;
+		}
+		p = s->map + (row * s->map_w) + col;
+		for(i = 0; i < n; i++, row++, p += s->map_w)
+			out[i] = ((row >= 0) && (row < s->map_h)) ? *p : 0;
+	}
+	else {
+		if((row < 0) || (row >= s->map_h)) {
+			for(i = 0; i < n; i++)
+				out[i] = 0;
+			return;
+		}
+		p = s->map + (row * s->map_w) + col;
+		for(i = 0; i < n; i++, col++, p++)
+			out[i] = ((col >= 0) && (col < s->map_w)) ? *p : 0;
+	}
+}
+
+static void get_tiles(const struct king_scroller *s, int col, int row, int n,
+                      int vertical)
+{
+	if(s->map)
+		fetch_ram(s, col, row, n, vertical, run_buf);
+	else if(s->fetch)
+		s->fetch(s->user, col, row, n, vertical, run_buf);
+	else {
+		int i;
+		for(i = 0; i < n; i++)
+			run_buf[i] = 0;
+	}
+}
+
+static void write_run(const struct king_scroller *s, int offset, int incr,
+                      const u16 *src, int n)
+{
+	king_set_kram_write(s->bat + offset, incr);
+	king_kram_write_block(src, n);
+}
+
+// One map row, from map column col, into the BAT ring (wraps at bat_w)
+static void write_row(struct king_scroller *s, int col, int row)
+{
+	int bc = col & (s->bat_w - 1);
+	int addr = (row & (s->bat_h - 1)) * s->bat_w;
+	int first = s->bat_w - bc;
+
+	get_tiles(s, col, row, s->cols, 0);
+
+	if(first >= s->cols) {
+		write_run(s, addr + bc, 1, run_buf, s->cols);
+	}
+	else {
+		write_run(s, addr + bc, 1, run_buf, first);
+		write_run(s, addr, 1, run_buf + first, s->cols - first);
+	}
+}
+
+// One map column, from map row row, with the write increment at bat_w
+static void write_column(struct king_scroller *s, int col, int row)
+{
+	int bc = col & (s->bat_w - 1);
+	int br = row & (s->bat_h - 1);
+	int first = s->bat_h - br;
+
+	get_tiles(s, col, row, s->rows, 1);
+
+	if(first >= s->rows) {
+		write_run(s, (br * s->bat_w) + bc, s->bat_w, run_buf, s->rows);
+	}
+	else {
+		write_run(s, (br * s->bat_w) + bc, s->bat_w, run_buf, first);
+		write_run(s, bc, s->bat_w, run_buf + first, s->rows - first);
+	}
+}
+
+static void set_position(struct king_scroller *s, int x, int y)
+{
+	s->x = x;
+	s->y = y;
+	king_set_scroll(s->bg, x & ((s->bat_w * 8) - 1), y & ((s->bat_h * 8) - 1));
+}
+
+int king_scroller_init(struct king_scroller *s, king_bg bg, u32 bat,
+                       king_bgsize h, king_bgsize w, int view_w, int view_h)
+{
+	s->bg = bg;
+	s->bat = bat;
+	s->bat_w = (1 << w) >> 3;
+	s->bat_h = (1 << h) >> 3;
+
+	s->cols = ((view_w + 7) >> 3) + 1;
+	s->rows = ((view_h + 7) >> 3) + 1;
+	s->col0 = s->row0 = 0;
+	s->x = s->y = 0;
+	s->map = 0;
+	s->map_w = s->map_h = 0;
+	s->fetch = 0;
+	s->user = 0;
+
+	return (s->cols <= s->bat_w) && (s->rows <= s->bat_h) &&
+	       (s->cols <= MAX_RUN) && (s->rows <= MAX_RUN);
+}
+
+void king_scroller_set_map(struct king_scroller *s, const u16 *map, int w, int h)
+{
+	s->map = map;
+	s->map_w = w;
+	s->map_h = h;
+}
+
+void king_scroller_set_fetch(struct king_scroller *s, king_scroller_fetch fetch,
+                             void *user)
+{
+	s->map = 0;
+	s->fetch = fetch;
+	s->user = user;
+}
+
+void king_scroller_redraw(struct king_scroller *s, int x, int y)
+{
+	int i;
+
+	s->col0 = x >> 3;
+	s->row0 = y >> 3;
+
+	for(i = 0; i < s->rows; i++)
+		write_row(s, s->col0, s->row0 + i);
+
+	set_position(s, x, y);
+}
+
+void king_scroller_move(struct king_scroller *s, int x, int y)
+{
+	int col = x >> 3;
+	int row = y >> 3;
+	int dc = col - s->col0;
+	int dr = row - s->row0;
+
+	if((dc >= s->cols) || (-dc >= s->cols) || (dr >= s->rows) || (-dr >= s->rows)) {
+		king_scroller_redraw(s, x, y);
+		return;
+	}
+
+	while(s->col0 < col) {                  // moving right: new column on the right
+		write_column(s, s->col0 + s->cols, s->row0);
+		s->col0++;
+	}
+	while(s->col0 > col) {                  // moving left
+		s->col0--;
+		write_column(s, s->col0, s->row0);
+	}
+
+	while(s->row0 < row) {                  // moving down: new row at the bottom
+		write_row(s, s->col0, s->row0 + s->rows);
+		s->row0++;
+	}
+	while(s->row0 > row) {                  // moving up
+		s->row0--;
+		write_row(s, s->col0, s->row0);
+	}
+
+	set_position(s, x, y);
+}
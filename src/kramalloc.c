@@ -0,0 +1,161 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include <pcfx/types.h>
+#include <pcfx/king.h>
+#include <pcfx/kramalloc.h>
+
+#define BLOCK_SHIFT   10
+#define BLOCKS        256                      // per page
+#define MAP_WORDS     (BLOCKS / 32)
+#define PAGE_BIT      0x80000000
+
+static u32 used_map[2][MAP_WORDS];
+static u8 use_page[KING_KRAM_USES];
+static int page_used[2], page_peak[2];
+static int use_words[KING_KRAM_USES], use_peak[KING_KRAM_USES];
+
+static int is_used(const u32 *map, int block)
+{
+	return (map[block >> 5] >> (block & 31)) & 1;
+}
+
+static int mark(u32 *map, int block, int blocks, int used)
+{
+	int changed = 0;
+
+	for(; blocks > 0; blocks--, block++) {
+		if(is_used(map, block) == used)
+			continue;
+		map[block >> 5] ^= 1u << (block & 31);
+		changed++;
+	}
+	return changed;
+}
+
+static int blocks_of(int words)
+{
+	return (words + KING_KRAM_BLOCK_WORDS - 1) >> BLOCK_SHIFT;
+}
+
+static void count(int page, int use, int words)
+{
+	page_used[page] += words;
+	if(page_used[page] > page_peak[page])
+		page_peak[page] = page_used[page];
+
+	if(use >= 0) {
+		use_words[use] += words;
+		if(use_words[use] > use_peak[use])
+			use_peak[use] = use_words[use];
+	}
+}
+
+void king_kalloc_init(u8 scsi, u8 bg, u8 rainbow, u8 adpcm)
+{
+	int i;
+
+	use_page[KING_KRAM_SCSI] = scsi & 1;
+	use_page[KING_KRAM_BG] = bg & 1;
+	use_page[KING_KRAM_RAINBOW] = rainbow & 1;
+	use_page[KING_KRAM_ADPCM] = adpcm & 1;
+	king_set_kram_pages(scsi & 1, bg & 1, rainbow & 1, adpcm & 1);
+
+	for(i = 0; i < MAP_WORDS; i++) {
+		used_map[0][i] = 0;
+		used_map[1][i] = 0;
+	}
+	page_used[0] = page_used[1] = 0;
+	page_peak[0] = page_peak[1] = 0;
+	for(i = 0; i < KING_KRAM_USES; i++)
+		use_words[i] = use_peak[i] = 0;
+}
+
+void king_kalloc_reserve(u32 addr, int words)
+{
+	int page = KING_KRAM_PAGE(addr);
+	int block = KING_KRAM_ADDR(addr) >> BLOCK_SHIFT;
+	int blocks = blocks_of(words + (addr & (KING_KRAM_BLOCK_WORDS - 1)));
+
+	if(block + blocks > BLOCKS)
+		blocks = BLOCKS - block;
+	count(page, -1, mark(used_map[page], block, blocks, 1) << BLOCK_SHIFT);
+}
+
+u32 king_kalloc(king_kram_use use, int words, int align)
+{
+	int page, blocks, step, start, i;
+	const u32 *map;
+
+	if((use < 0) || (use >= KING_KRAM_USES) || (words <= 0))
+		return KING_KALLOC_NONE;
+
+	page = use_page[use];
+	map = used_map[page];
+	blocks = blocks_of(words);
+	step = align >> BLOCK_SHIFT;
+	if(step < 1)
+		step = 1;
+
+	// first fit from the bottom of the page
+	start = 0;
+	while(start + blocks <= BLOCKS) {
+		for(i = 0; i < blocks; i++) {
+			if(is_used(map, start + i))
+				break;
+		}
+		if(i == blocks) {
+			mark(used_map[page], start, blocks, 1);
+			count(page, use, blocks << BLOCK_SHIFT);
+			return (page ? PAGE_BIT : 0) | (start << BLOCK_SHIFT);
+		}
+		start = (start + i + step) & ~(step - 1);
+	}
+	return KING_KALLOC_NONE;
+}
+
+void king_kfree(king_kram_use use, u32 addr, int words)
+{
+	int page = KING_KRAM_PAGE(addr);
+	int block = KING_KRAM_ADDR(addr) >> BLOCK_SHIFT;
+	int blocks = blocks_of(words);
+	int freed;
+
+	if(block + blocks > BLOCKS)
+		blocks = BLOCKS - block;
+	freed = mark(used_map[page], block, blocks, 0) << BLOCK_SHIFT;
+	page_used[page] -= freed;
+	if((use >= 0) && (use < KING_KRAM_USES))
+		use_words[use] -= freed;
+}
+
+void king_kalloc_stats(struct king_kalloc_stats *stats)
+{
+	int page, block, run, i;
+
+	for(page = 0; page < 2; page++) {
+		stats->used[page] = page_used[page];
+		stats->peak[page] = page_peak[page];
+		stats->largest_free[page] = 0;
+		run = 0;
+		for(block = 0; block < BLOCKS; block++) {
+			if(is_used(used_map[page], block)) {
+				run = 0;
+				continue;
+			}
+			run++;
+			if((run << BLOCK_SHIFT) > stats->largest_free[page])
+				stats->largest_free[page] = run << BLOCK_SHIFT;
+		}
+	}
+	for(i = 0; i < KING_KRAM_USES; i++) {
+		stats->use_words[i] = use_words[i];
+		stats->use_peak[i] = use_peak[i];
+	}
+}
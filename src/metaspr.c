@@ -0,0 +1,84 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include <pcfx/types.h>
+#include <pcfx/vdc.h>
+#include <pcfx/metaspr.h>
+
+#define SATB_ENTRIES    64
+
+static const u16 *bank_data;
+static u16 bank_pattern;
+static int next_entry[2];
+static int prev_end[2];         // one past the last entry used by the last frame
+static struct vdc_sprite burst[SATB_ENTRIES];
+
+void vdc_metaspr_bank(const u16 *bank, u16 pattern)
+{
+	bank_data = bank;
+	bank_pattern = pattern;
+}
+
+void vdc_metaspr_begin(int chip, int first)
+{
+	chip &= 1;
+	next_entry[chip] = first;
+}
+
+int vdc_metaspr_draw(int chip, int id, int x, int y, int flags)
+{
+	const struct vdc_metaspr_part *part;
+	const u16 *spr;
+	struct vdc_sprite *ent;
+	u16 flip = flags & (VDC_METASPR_FLIP_X | VDC_METASPR_FLIP_Y);
+	u16 pal = flags & 0xF;
+	int n, i;
+
+	chip &= 1;
+	if(!bank_data || (id < 0) || (id >= bank_data[0]))
+		return 0;
+
+	spr = (const u16 *)((const u8 *)bank_data + bank_data[1 + id]);
+	part = (const struct vdc_metaspr_part *)(spr + 2);
+	n = spr[0];
+	if(n > SATB_ENTRIES - next_entry[chip])
+		n = SATB_ENTRIES - next_entry[chip];
+	if(n <= 0)
+		return 0;
+
+	for(i = 0, ent = burst; i < n; i++, part++, ent++) {
+		ent->x = x + ((flip & VDC_METASPR_FLIP_X) ? part->dx_flip : part->dx);
+		ent->y = y + ((flip & VDC_METASPR_FLIP_Y) ? part->dy_flip : part->dy);
+		ent->pattern = part->pattern + bank_pattern;
+		ent->ctrl = (part->ctrl ^ flip) & ~0xF;
+		ent->ctrl |= (part->ctrl + pal) & 0xF;
+	}
+
+	vdc_spr_update_array(chip, next_entry[chip], n, burst);
+	next_entry[chip] += n;
+	return n;
+}
+
+void vdc_metaspr_end(int chip)
+{
+	int i, n;
+
+	chip &= 1;
+	n = prev_end[chip] - next_entry[chip];
+	if(n > 0) {
+		for(i = 0; i < n; i++) {
+			burst[i].y = 0;
+			burst[i].x = 0;
+			burst[i].pattern = 0;
+			burst[i].ctrl = 0;
+		}
+		vdc_spr_update_array(chip, next_entry[chip], n, burst);
+	}
+	prev_end[chip] = next_entry[chip];
+}
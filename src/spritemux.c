@@ -0,0 +1,193 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include <pcfx/types.h>
+#include <pcfx/vdc.h>
+#include <pcfx/spritemux.h>
+
+#define SATB_ENTRIES    64
+#define CELLS_PER_LINE  16      // 16-pixel sprite cells one VDC can show on a line
+#define SCREEN_LINES    256
+#define SCREEN_RIGHT    (32 + 352)   // widest display, in SATB X coordinates
+#define Y_BUCKETS       512     // sort key is SATB Y / 2
+
+static u16 sorted[VDC_MUX_MAX];
+static u16 bucket[Y_BUCKETS];
+static u8  line_cells[2][SCREEN_LINES];
+static u8  line_drops[SCREEN_LINES];
+static struct vdc_sprite satb[2][SATB_ENTRIES];
+static int satb_prev[2];        // entries used by the previous update
+static int mux_chips = 1;
+static int rotation;
+
+static void sort_by_y(const struct vdc_mux_sprite *list, int count)
+{
+	int i, key, sum, n;
+
+	for(i = 0; i < Y_BUCKETS; i++)
+		bucket[i] = 0;
+
+	for(i = 0; i < count; i++)
+		bucket[(list[i].y >> 1) & (Y_BUCKETS - 1)]++;
+
+	sum = 0;
+	for(i = 0; i < Y_BUCKETS; i++) {
+		n = bucket[i];
+		bucket[i] = sum;
+		sum += n;
+	}
+
+	for(i = 0; i < count; i++) {
+		key = (list[i].y >> 1) & (Y_BUCKETS - 1);
+		sorted[bucket[key]++] = i;
+	}
+}
+
+static int spr_height(u16 ctrl)
+{
+	switch(ctrl & VDC_SPR_Y_HEIGHT_4) {
+	case VDC_SPR_Y_HEIGHT_1:
+		return 16;
+	case VDC_SPR_Y_HEIGHT_2:
+		return 32;
+	default:
+		return 64;
+	}
+}
+
+static int lines_free(const u8 *cells, int top, int bottom, int need)
+{
+	int line;
+
+	for(line = top; line < bottom; line++) {
+		if(cells[line] + need > CELLS_PER_LINE)
+			return 0;
+	}
+	return 1;
+}
+
+void vdc_mux_init(int chips)
+{
+	mux_chips = (chips == 2) ? 2 : 1;
+	satb_prev[0] = SATB_ENTRIES;    // first update hides everything else
+	satb_prev[1] = SATB_ENTRIES;
+	rotation = 0;
+}
+
+void vdc_mux_update(const struct vdc_mux_sprite *list, int count,
+                    struct vdc_mux_stats *stats)
+{
+	const struct vdc_mux_sprite *spr;
+	struct vdc_sprite *ent;
+	int used[2];
+	int i, k, chip, line, top, bottom, cells;
+	int shown, dropped, offscreen, first_drop;
+
+	if(count > VDC_MUX_MAX)
+		count = VDC_MUX_MAX;
+
+	sort_by_y(list, count);
+
+	for(line = 0; line < SCREEN_LINES; line++) {
+		line_cells[0][line] = 0;
+		line_cells[1][line] = 0;
+		line_drops[line] = 0;
+	}
+
+	used[0] = used[1] = 0;
+	shown = dropped = offscreen = 0;
+	first_drop = -1;
+
+	if(rotation >= count)
+		rotation = 0;
+	k = rotation;
+
+	for(i = 0; i < count; i++, k++) {
+		if(k == count)
+			k = 0;
+		spr = &list[sorted[k]];
+
+		top = (int)spr->y - 64;
+		bottom = top + spr_height(spr->ctrl);
+		cells = (spr->ctrl & VDC_SPR_X_WIDTH_2) ? 2 : 1;
+
+		if((bottom <= 0) || (top >= SCREEN_LINES) ||
+		   (spr->x + cells * 16 <= 32) || (spr->x >= SCREEN_RIGHT)) {
+			offscreen++;
+			continue;
+		}
+		if(top < 0)
+			top = 0;
+		if(bottom > SCREEN_LINES)
+			bottom = SCREEN_LINES;
+
+		for(chip = 0; chip < mux_chips; chip++) {
+			if(used[chip] == SATB_ENTRIES)
+				continue;
+			if(lines_free(line_cells[chip], top, bottom, cells))
+				break;
+		}
+
+		if(chip == mux_chips) {
+			if(first_drop < 0)
+				first_drop = k;
+			dropped++;
+			for(line = top; line < bottom; line++) {
+				if(line_drops[line] != 0xFF)
+					line_drops[line]++;
+			}
+			continue;
+		}
+
+		for(line = top; line < bottom; line++)
+			line_cells[chip][line] += cells;
+
+		ent = &satb[chip][used[chip]++];
+		ent->y = spr->y;
+		ent->x = spr->x;
+		ent->pattern = spr->pattern;
+		ent->ctrl = spr->ctrl;
+		shown++;
+	}
+
+	if(first_drop >= 0)
+		rotation = first_drop;
+
+	for(chip = 0; chip < mux_chips; chip++) {
+		// hide entries that were used last frame but not in this one
+		for(i = used[chip]; i < satb_prev[chip]; i++)
+			satb[chip][i].y = 0;
+
+		k = (used[chip] > satb_prev[chip]) ? used[chip] : satb_prev[chip];
+		if(k != 0)
+			vdc_spr_update_array(chip, 0, k, satb[chip]);
+		satb_prev[chip] = used[chip];
+	}
+
+	if(stats) {
+		stats->shown = shown;
+		stats->dropped = dropped;
+		stats->offscreen = offscreen;
+		stats->worst_line = -1;
+		k = 0;
+		for(line = 0; line < SCREEN_LINES; line++) {
+			if(line_drops[line] > k) {
+				k = line_drops[line];
+				stats->worst_line = line;
+			}
+		}
+	}
+}
+
+int vdc_mux_line_drops(int line)
+{
+	if((line < 0) || (line >= SCREEN_LINES))
+		return 0;
+	return line_drops[line];
+}
@@ -0,0 +1,224 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include <pcfx/types.h>
+#include <pcfx/std.h>
+#include <pcfx/vdc.h>
+#include <pcfx/vdcalloc.h>
+
+#define UNIT_SHIFT   4                         // 16 words per unit
+#define UNITS        (0x10000 >> UNIT_SHIFT)   // 4096 per VDC
+#define MAP_WORDS    (UNITS / 32)
+#define SATB_ADDR    0xFF00
+#define SATB_WORDS   0x100
+
+struct pattern {
+	const u16 *data;
+	u32 hash;
+	u16 vaddr;
+	u16 words;
+	u16 refs;                // 0 = slot is free
+};
+
+static u32 used_map[2][MAP_WORDS];
+static struct pattern patterns[2][VDC_VALLOC_PATTERNS];
+
+static int is_used(const u32 *map, int unit)
+{
+	return (map[unit >> 5] >> (unit & 31)) & 1;
+}
+
+static void mark(u32 *map, int unit, int units, int used)
+{
+	for(; units > 0; units--, unit++) {
+		if(used)
+			map[unit >> 5] |= 1u << (unit & 31);
+		else
+			map[unit >> 5] &= ~(1u << (unit & 31));
+	}
+}
+
+static int units_of(int words)
+{
+	return (words + (1 << UNIT_SHIFT) - 1) >> UNIT_SHIFT;
+}
+
+// First fit, trying only starts that are a multiple of step
+static int find_free(const u32 *map, int units, int step)
+{
+	int start = 0;
+	int i;
+
+	while(start + units <= UNITS) {
+		if(map[start >> 5] == 0xFFFFFFFF) {     // skip 32 used units at once
+			start = ((start | 31) + step) & ~(step - 1);
+			continue;
+		}
+		for(i = 0; i < units; i++) {
+			if(is_used(map, start + i))
+				break;
+		}
+		if(i == units)
+			return start;
+		start = (start + i + step) & ~(step - 1);
+	}
+	return -1;
+}
+
+static u32 hash_data(const u16 *data, int words)
+{
+	u32 h = 0x811C9DC5;
+	int i;
+
+	for(i = 0; i < words; i++)
+		h = (h ^ data[i]) * 0x01000193;
+	return h;
+}
+
+void vdc_valloc_init(int chip, int bat_words)
+{
+	int i;
+
+	chip &= 1;
+	for(i = 0; i < MAP_WORDS; i++)
+		used_map[chip][i] = 0;
+	for(i = 0; i < VDC_VALLOC_PATTERNS; i++)
+		patterns[chip][i].refs = 0;
+
+	vdc_valloc_reserve(chip, 0, bat_words);
+	vdc_valloc_reserve(chip, SATB_ADDR, SATB_WORDS);
+}
+
+void vdc_valloc_reserve(int chip, u16 vaddr, int words)
+{
+	int unit = vaddr >> UNIT_SHIFT;
+	int units = units_of(words + (vaddr & ((1 << UNIT_SHIFT) - 1)));
+
+	if(unit + units > UNITS)
+		units = UNITS - unit;
+	mark(used_map[chip & 1], unit, units, 1);
+}
+
+int vdc_valloc(int chip, int words, int align)
+{
+	int units = units_of(words);
+	int step = align >> UNIT_SHIFT;
+	int unit;
+
+	if(units <= 0)
+		return -1;
+	if(step < 1)
+		step = 1;
+
+	unit = find_free(used_map[chip & 1], units, step);
+	if(unit < 0)
+		return -1;
+
+	mark(used_map[chip & 1], unit, units, 1);
+	return unit << UNIT_SHIFT;
+}
+
+void vdc_vfree(int chip, u16 vaddr, int words)
+{
+	int unit = vaddr >> UNIT_SHIFT;
+	int units = units_of(words);
+
+	if(unit + units > UNITS)
+		units = UNITS - unit;
+	mark(used_map[chip & 1], unit, units, 0);
+}
+
+int vdc_pattern_load(int chip, const u16 *data, int words, int align)
+{
+	struct pattern *tab = patterns[chip & 1];
+	struct pattern *slot = 0;
+	u32 hash = hash_data(data, words);
+	int i, vaddr;
+
+	if(align < VDC_VALLOC_TILE)
+		align = VDC_VALLOC_TILE;
+
+	for(i = 0; i < VDC_VALLOC_PATTERNS; i++) {
+		if(tab[i].refs == 0) {
+			if(!slot)
+				slot = &tab[i];
+			continue;
+		}
+		if((tab[i].words != words) || (tab[i].hash != hash))
+			continue;
+		if((tab[i].vaddr & (align - 1)) != 0)
+			continue;
+		if((tab[i].data == data) || (memcmp16(tab[i].data, data, words * 2) == 0)) {
+			tab[i].refs++;
+			return tab[i].vaddr;
+		}
+	}
+
+	if(!slot)
+		return -1;
+
+	vaddr = vdc_valloc(chip, words, align);
+	if(vaddr < 0)
+		return -1;
+
+	vdc_vram_write_block(chip, vaddr, data, words);
+
+	slot->data = data;
+	slot->hash = hash;
+	slot->vaddr = vaddr;
+	slot->words = words;
+	slot->refs = 1;
+	return vaddr;
+}
+
+void vdc_pattern_release(int chip, u16 vaddr)
+{
+	struct pattern *tab = patterns[chip & 1];
+	int i;
+
+	for(i = 0; i < VDC_VALLOC_PATTERNS; i++) {
+		if((tab[i].refs != 0) && (tab[i].vaddr == vaddr)) {
+			if(--tab[i].refs == 0)
+				vdc_vfree(chip, vaddr, tab[i].words);
+			return;
+		}
+	}
+}
+
+void vdc_valloc_stats(int chip, struct vdc_valloc_stats *stats)
+{
+	const u32 *map = used_map[chip & 1];
+	int unit, run = 0;
+	int i;
+
+	stats->free_words = 0;
+	stats->largest_free = 0;
+	stats->free_areas = 0;
+	stats->patterns = 0;
+
+	for(unit = 0; unit <= UNITS; unit++) {
+		if((unit < UNITS) && !is_used(map, unit)) {
+			run++;
+			continue;
+		}
+		if(run) {
+			stats->free_areas++;
+			stats->free_words += run << UNIT_SHIFT;
+			if((run << UNIT_SHIFT) > stats->largest_free)
+				stats->largest_free = run << UNIT_SHIFT;
+			run = 0;
+		}
+	}
+	stats->used_words = 0x10000 - stats->free_words;
+
+	for(i = 0; i < VDC_VALLOC_PATTERNS; i++) {
+		if(patterns[chip & 1][i].refs)
+			stats->patterns++;
+	}
+}
@@ -0,0 +1,226 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+/*
+ * fmvpack -- builds FMV streams for <pcfx/fmv.h> (host tool)
+ *
+ * Build:  cc -O2 -o fmvpack fmvpack.c
+ * Usage:  fmvpack [options] list.txt output.fmv
+ *
+ *   -w width     picture width in pixels (default 256)
+ *   -h height    picture height in pixels (default 240)
+ *   -v vblanks   VBlanks per frame (default 4 = 15 frames/second)
+ *   -r rate      adpcm_rate value stored for the player (default 0)
+ *
+ * Each line of the list gives one frame: the file with its compressed
+ * picture, already in the form RAINBOW takes, then optionally the file
+ * with its ADPCM audio ('-' or nothing for none). '#' starts a comment.
+ *
+ * This only packs; pictures and audio come from an encoder.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SECTOR       2048
+#define HEADER_SIZE  32
+#define MAX_FRAMES   0x40000
+
+struct frame {
+	char video[256], audio[256];
+	long video_size, audio_size;
+};
+
+static struct frame *frames;
+static int nframes;
+
+static long file_size(const char *name)
+{
+	FILE *fp = fopen(name, "rb");
+	long n;
+
+	if(!fp) {
+		perror(name);
+		exit(1);
+	}
+	fseek(fp, 0, SEEK_END);
+	n = ftell(fp);
+	fclose(fp);
+	return n;
+}
+
+static long sectors(long bytes)
+{
+	return (bytes + SECTOR - 1) / SECTOR;
+}
+
+static void put16(unsigned char *p, unsigned v)
+{
+	p[0] = v & 0xFF;
+	p[1] = (v >> 8) & 0xFF;
+}
+
+static void put32(unsigned char *p, unsigned long v)
+{
+	put16(p, v & 0xFFFF);
+	put16(p + 2, (v >> 16) & 0xFFFF);
+}
+
+/* Copy a file, padded with zeroes to whole sectors */
+static void copy_padded(FILE *out, const char *name)
+{
+	static unsigned char buf[SECTOR];
+	FILE *fp = fopen(name, "rb");
+	size_t n;
+
+	if(!fp) {
+		perror(name);
+		exit(1);
+	}
+	while((n = fread(buf, 1, SECTOR, fp)) > 0) {
+		if(n < SECTOR)
+			memset(buf + n, 0, SECTOR - n);
+		fwrite(buf, 1, SECTOR, out);
+	}
+	fclose(fp);
+}
+
+static void read_list(const char *name)
+{
+	FILE *fp = fopen(name, "r");
+	char line[600], *c;
+	int line_no = 0;
+
+	if(!fp) {
+		perror(name);
+		exit(1);
+	}
+	frames = calloc(MAX_FRAMES, sizeof(*frames));
+	if(!frames) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+
+	while(fgets(line, sizeof(line), fp)) {
+		struct frame *f;
+		int n;
+
+		line_no++;
+		if((c = strchr(line, '#')))
+			*c = 0;
+		if(nframes == MAX_FRAMES) {
+			fprintf(stderr, "%s:%d: too many frames\n", name, line_no);
+			exit(1);
+		}
+		f = &frames[nframes];
+		n = sscanf(line, "%255s %255s", f->video, f->audio);
+		if(n < 1)
+			continue;
+		if((n < 2) || !strcmp(f->audio, "-"))
+			f->audio[0] = 0;
+
+		f->video_size = file_size(f->video);
+		f->audio_size = f->audio[0] ? file_size(f->audio) : 0;
+		if((sectors(f->video_size) > 255) || (sectors(f->audio_size) > 255)) {
+			fprintf(stderr, "%s:%d: a part is larger than 255 sectors\n", name, line_no);
+			exit(1);
+		}
+		if(f->video_size == 0) {
+			fprintf(stderr, "%s:%d: empty picture\n", name, line_no);
+			exit(1);
+		}
+		nframes++;
+	}
+	fclose(fp);
+}
+
+int main(int argc, char *argv[])
+{
+	int width = 256, height = 240, vblanks = 4, rate = 0;
+	long max_video = 0, max_audio = 0, header_sectors;
+	unsigned char *hdr;
+	FILE *out;
+	int i;
+
+	while((argc > 3) && (argv[1][0] == '-')) {
+		int v = atoi(argv[2]);
+
+		switch(argv[1][1]) {
+		case 'w': width = v; break;
+		case 'h': height = v; break;
+		case 'v': vblanks = v; break;
+		case 'r': rate = v; break;
+		default:
+			fprintf(stderr, "unknown option %s\n", argv[1]);
+			return 1;
+		}
+		argc -= 2;
+		argv += 2;
+	}
+	if(argc != 3) {
+		fprintf(stderr, "usage: fmvpack [-w width] [-h height] [-v vblanks] [-r rate] list.txt output.fmv\n");
+		return 1;
+	}
+	if(vblanks < 1) {
+		fprintf(stderr, "vblanks must be 1 or more\n");
+		return 1;
+	}
+
+	read_list(argv[1]);
+	if(nframes == 0) {
+		fprintf(stderr, "no frames\n");
+		return 1;
+	}
+
+	for(i = 0; i < nframes; i++) {
+		if(sectors(frames[i].video_size) > max_video)
+			max_video = sectors(frames[i].video_size);
+		if(sectors(frames[i].audio_size) > max_audio)
+			max_audio = sectors(frames[i].audio_size);
+	}
+
+	header_sectors = sectors(HEADER_SIZE + nframes * 2);
+	hdr = calloc(header_sectors, SECTOR);
+	if(!hdr) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	memcpy(hdr, "PFMV", 4);
+	put16(hdr + 4, 1);
+	put16(hdr + 6, header_sectors);
+	put32(hdr + 8, nframes);
+	put16(hdr + 12, width);
+	put16(hdr + 14, height);
+	put16(hdr + 16, vblanks);
+	put16(hdr + 18, rate);
+	put16(hdr + 20, max_video);
+	put16(hdr + 22, max_audio);
+	for(i = 0; i < nframes; i++) {
+		hdr[HEADER_SIZE + i * 2] = sectors(frames[i].video_size);
+		hdr[HEADER_SIZE + i * 2 + 1] = sectors(frames[i].audio_size);
+	}
+
+	out = fopen(argv[2], "wb");
+	if(!out) {
+		perror(argv[2]);
+		return 1;
+	}
+	fwrite(hdr, SECTOR, header_sectors, out);
+	for(i = 0; i < nframes; i++) {
+		copy_padded(out, frames[i].video);
+		if(frames[i].audio[0])
+			copy_padded(out, frames[i].audio);
+	}
+	fclose(out);
+
+	printf("%d frames, %ld header sectors, largest picture %ld sectors, largest audio %ld sectors\n",
+	       nframes, header_sectors, max_video, max_audio);
+	return 0;
+}
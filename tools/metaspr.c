@@ -0,0 +1,261 @@
+/*
+        libpcfx -- A set of libraries for controlling the NEC PC-FX
+
+Copyright (C) 2026              libpcfx contributors
+
+# This code is licensed to you under the terms of the MIT license;
+# see file LICENSE or http://www.opensource.org/licenses/mit-license.php
+*/
+
+/*
+ * metaspr -- builds metasprite banks for <pcfx/metaspr.h> (host tool)
+ *
+ * Build:  cc -O2 -o metaspr metaspr.c
+ * Usage:  metaspr [-b] input.txt output [name]
+ *
+ *   Writes a C array called name (default "metaspr_bank"), or a raw
+ *   little-endian binary with -b.
+ *
+ * Input, one statement per line, '#' starts a comment:
+ *
+ *   sprite <name>
+ *   part <dx> <dy> <width> <height> <cell> [pal] [sp|bg]
+ *   end
+ *
+ *   dx, dy:  position of the part's top-left corner from the anchor, in pixels
+ *   width:   16 or 32
+ *   height:  16, 32 or 64
+ *   cell:    64-word sprite cell, counted from where the patterns are loaded
+ *   pal:     palette, 0 ~ 15 (default 0)
+ *   sp|bg:   in front of (default) or behind the background
+ *
+ * Metasprites are numbered in the order they appear; with a C array, a
+ * #define <NAME>_<SPRITE> is also written for each.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define MAX_SPRITES   1024
+#define MAX_PARTS     64      /* a whole SATB */
+
+struct part {
+	int dx, dy, dx_flip, dy_flip;
+	unsigned pattern, ctrl;
+};
+
+struct sprite {
+	char name[64];
+	int nparts;
+	struct part parts[MAX_PARTS];
+};
+
+static struct sprite sprites[MAX_SPRITES];
+static int nsprites;
+
+static unsigned char out[0x100000];
+static int outlen;
+
+static void fail(const char *file, int line, const char *msg)
+{
+	fprintf(stderr, "%s:%d: %s\n", file, line, msg);
+	exit(1);
+}
+
+static void put16(unsigned v)
+{
+	if(outlen + 2 > (int)sizeof(out)) {
+		fprintf(stderr, "output too large\n");
+		exit(1);
+	}
+	out[outlen++] = v & 0xFF;
+	out[outlen++] = (v >> 8) & 0xFF;
+}
+
+static void set16(int at, unsigned v)
+{
+	out[at] = v & 0xFF;
+	out[at + 1] = (v >> 8) & 0xFF;
+}
+
+static void parse(const char *file)
+{
+	FILE *fp = fopen(file, "r");
+	char buf[256], kw[16], opt[16];
+	struct sprite *cur = NULL;
+	struct part *p;
+	int line = 0;
+	int dx, dy, w, h, cell, pal, n;
+
+	if(!fp) {
+		perror(file);
+		exit(1);
+	}
+
+	while(fgets(buf, sizeof(buf), fp)) {
+		char *c = strchr(buf, '#');
+
+		line++;
+		if(c)
+			*c = 0;
+		if(sscanf(buf, "%15s", kw) != 1)
+			continue;
+
+		if(!strcmp(kw, "sprite")) {
+			if(cur)
+				fail(file, line, "missing 'end'");
+			if(nsprites == MAX_SPRITES)
+				fail(file, line, "too many sprites");
+			cur = &sprites[nsprites++];
+			if(sscanf(buf, "%*s %63s", cur->name) != 1)
+				fail(file, line, "sprite needs a name");
+			cur->nparts = 0;
+		}
+		else if(!strcmp(kw, "end")) {
+			if(!cur)
+				fail(file, line, "'end' without 'sprite'");
+			cur = NULL;
+		}
+		else if(!strcmp(kw, "part")) {
+			if(!cur)
+				fail(file, line, "'part' outside a sprite");
+			if(cur->nparts == MAX_PARTS)
+				fail(file, line, "more than 64 parts");
+
+			pal = 0;
+			strcpy(opt, "sp");
+			n = sscanf(buf, "%*s %d %d %d %d %d %d %15s",
+			           &dx, &dy, &w, &h, &cell, &pal, opt);
+			if(n < 5)
+				fail(file, line, "part needs dx dy width height cell");
+			if((w != 16) && (w != 32))
+				fail(file, line, "width must be 16 or 32");
+			if((h != 16) && (h != 32) && (h != 64))
+				fail(file, line, "height must be 16, 32 or 64");
+			if((pal < 0) || (pal > 15))
+				fail(file, line, "palette must be 0 ~ 15");
+			if((cell < 0) || (cell > 1023))
+				fail(file, line, "cell must be 0 ~ 1023");
+			if(cell & ((w / 16) * (h / 16) - 1))
+				fprintf(stderr, "%s:%d: warning: cell %d is not aligned for a %dx%d sprite\n",
+				        file, line, cell, w, h);
+
+			p = &cur->parts[cur->nparts++];
+			p->dx = dx;
+			p->dy = dy;
+			p->dx_flip = -(dx + w);
+			p->dy_flip = -(dy + h);
+			p->pattern = cell << 1;          /* VDC_SPR_PATTERN() units */
+			p->ctrl = pal;
+			if(w == 32)
+				p->ctrl |= 0x100;                /* VDC_SPR_X_WIDTH_2 */
+			if(h == 32)
+				p->ctrl |= 0x1000;               /* VDC_SPR_Y_HEIGHT_2 */
+			else if(h == 64)
+				p->ctrl |= 0x3000;               /* VDC_SPR_Y_HEIGHT_4 */
+			if(!strcmp(opt, "sp"))
+				p->ctrl |= 0x80;                 /* VDC_SPR_PRIO_SP */
+			else if(strcmp(opt, "bg"))
+				fail(file, line, "priority must be sp or bg");
+		}
+		else {
+			fail(file, line, "unknown statement");
+		}
+	}
+	if(cur)
+		fail(file, line, "missing 'end'");
+	fclose(fp);
+}
+
+static void build(void)
+{
+	int i, j;
+
+	put16(nsprites);
+	for(i = 0; i < nsprites; i++)
+		put16(0);                   /* offsets, filled in below */
+	if(outlen & 2)
+		put16(0);
+
+	for(i = 0; i < nsprites; i++) {
+		set16(2 + i * 2, outlen);
+		if(outlen > 0xFFFF) {
+			fprintf(stderr, "bank larger than 64K bytes\n");
+			exit(1);
+		}
+		put16(sprites[i].nparts);
+		put16(0);
+		for(j = 0; j < sprites[i].nparts; j++) {
+			struct part *p = &sprites[i].parts[j];
+			put16(p->dx);
+			put16(p->dy);
+			put16(p->dx_flip);
+			put16(p->dy_flip);
+			put16(p->pattern);
+			put16(p->ctrl);
+		}
+	}
+}
+
+static void write_c(FILE *fp, const char *name)
+{
+	char upper[64];
+	int i;
+
+	for(i = 0; name[i] && (i < 63); i++)
+		upper[i] = toupper((unsigned char)name[i]);
+	upper[i] = 0;
+
+	fprintf(fp, "/* Generated by metaspr */\n\n");
+	for(i = 0; i < nsprites; i++) {
+		char sname[64];
+		int k;
+
+		for(k = 0; sprites[i].name[k]; k++)
+			sname[k] = toupper((unsigned char)sprites[i].name[k]);
+		sname[k] = 0;
+		fprintf(fp, "#define %s_%s %d\n", upper, sname, i);
+	}
+	fprintf(fp, "\nconst unsigned short %s[%d] __attribute__((aligned(4))) = {", name, outlen / 2);
+	for(i = 0; i < outlen; i += 2) {
+		fprintf(fp, "%s0x%04X,", (i % 16) ? " " : "\n\t",
+		        out[i] | (out[i + 1] << 8));
+	}
+	fprintf(fp, "\n};\n");
+}
+
+int main(int argc, char *argv[])
+{
+	const char *name = "metaspr_bank";
+	int binary = 0;
+	FILE *fp;
+
+	if((argc > 1) && !strcmp(argv[1], "-b")) {
+		binary = 1;
+		argc--;
+		argv++;
+	}
+	if((argc != 3) && (argc != 4)) {
+		fprintf(stderr, "usage: metaspr [-b] input.txt output [name]\n");
+		return 1;
+	}
+	if(argc == 4)
+		name = argv[3];
+
+	parse(argv[1]);
+	build();
+
+	fp = fopen(argv[2], binary ? "wb" : "w");
+	if(!fp) {
+		perror(argv[2]);
+		return 1;
+	}
+	if(binary)
+		fwrite(out, 1, outlen, fp);
+	else
+		write_c(fp, name);
+	fclose(fp);
+	return 0;
+}